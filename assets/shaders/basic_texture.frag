@@ -1,10 +1,9 @@
 out vec4 FragColor;
 in vec2 TexCoord;
+in vec3 vColor;
 
 uniform sampler2D uTexture;
-uniform vec3 uColor;
 uniform bool uUseTexture;
-uniform float uTime;
 
 void main()
 {
@@ -16,10 +15,10 @@ void main()
         if (texColor.a < 0.01) {
             discard; // Skip fully transparent pixels
         }
-        finalColor = vec4(texColor.rgb * uColor, texColor.a);
+        finalColor = vec4(texColor.rgb * vColor, texColor.a);
         alpha = texColor.a;
     } else {
-        finalColor = vec4(uColor, 1.0);
+        finalColor = vec4(vColor, 1.0);
         alpha = 1.0;
     }
 
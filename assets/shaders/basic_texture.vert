@@ -1,15 +1,25 @@
 layout (location = 0) in vec2 aPos;
 layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in mat4 aInstanceModel;
+layout (location = 6) in vec3 aInstanceColor;
+layout (location = 9) in vec4 aInstanceUVRect;
 
 out vec2 TexCoord;
+out vec3 vColor;
 
-uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
-uniform float uTime;
+layout (std140) uniform RasterFrame
+{
+    highp mat4 uView;
+    highp mat4 uProjection;
+    highp mat4 uViewProjection;
+    highp float uTime;
+    highp float uDeltaTime;
+    highp vec2 uViewportSize;
+};
 
 void main()
 {
-    gl_Position = uProjection * uView * uModel * vec4(aPos, 0.0, 1.0);
-    TexCoord = aTexCoord;
+    gl_Position = uViewProjection * aInstanceModel * vec4(aPos, 0.0, 1.0);
+    TexCoord = aInstanceUVRect.xy + aTexCoord * aInstanceUVRect.zw;
+    vColor = aInstanceColor;
 }
\ No newline at end of file
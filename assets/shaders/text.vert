@@ -2,12 +2,20 @@ layout (location = 0) in vec2 aPos;
 layout (location = 1) in vec2 aTexCoord;
 
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
+
+layout (std140) uniform RasterFrame
+{
+    highp mat4 uView;
+    highp mat4 uProjection;
+    highp mat4 uViewProjection;
+    highp float uTime;
+    highp float uDeltaTime;
+    highp vec2 uViewportSize;
+};
 
 out vec2 TexCoord;
 
 void main() {
-    gl_Position = uProjection * uView * uModel * vec4(aPos, 0.0, 1.0);
+    gl_Position = uViewProjection * uModel * vec4(aPos, 0.0, 1.0);
     TexCoord = aTexCoord;
 }
\ No newline at end of file
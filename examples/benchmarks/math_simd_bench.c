@@ -0,0 +1,266 @@
+/*
+    math_simd_bench - SIMD math functions against linmath's scalar reference
+
+    Feeds BENCH_SAMPLE_COUNT random matrices, vectors and quaternions through mat4x4_mul_simd,
+    mat4x4_mul_vec4_simd, quat_mul_simd and mat4x4_mul_affine, counts results that differ from
+    linmath bit for bit, and logs ns per call for both paths. Build with -DRASTER_MATH_SIMD=ON
+    to exercise the SIMD backend; without it the *_simd functions are the scalar code.
+
+    mat4x4_mul_affine is compared with ==, since mat4x4_mul's extra "+ a * 0" term can turn a
+    -0 into +0. Runs without a window; it only needs the math headers.
+*/
+
+#include "raster/raster.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_SAMPLE_COUNT 16384
+#define BENCH_ITERATIONS   64
+
+typedef struct
+{
+    mat4x4* a;
+    mat4x4* b;
+    vec4*   v;
+    quat*   p;
+    quat*   q;
+    mat4x4* reference;
+    mat4x4* result;
+} bench_state_t;
+
+static bench_state_t B;
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static float bench_random(void)
+{
+    // Occasional exact zeros exercise signed-zero handling
+    if ((rand() & 15) == 0)
+    {
+        return (rand() & 1) ? 0.0f : -0.0f;
+    }
+    return -100.0f + 200.0f * ((float)rand() / (float)RAND_MAX);
+}
+
+static void bench_random_affine(mat4x4 M)
+{
+    for (int col = 0; col < 4; ++col)
+    {
+        for (int row = 0; row < 3; ++row)
+        {
+            M[col][row] = bench_random();
+        }
+        M[col][3] = col == 3 ? 1.0f : 0.0f;
+    }
+}
+
+static void bench_report(const char* name, double scalar_seconds, double simd_seconds, int mismatches)
+{
+    double calls = (double)BENCH_SAMPLE_COUNT * BENCH_ITERATIONS;
+    rlog_info("math_simd_bench: %-14s scalar %7.2f ns  simd %7.2f ns  mismatches %d",
+              name,
+              1e9 * scalar_seconds / calls,
+              1e9 * simd_seconds / calls,
+              mismatches);
+}
+
+static int bench_count_mismatches(const void* reference, const void* result, size_t stride)
+{
+    int mismatches = 0;
+    for (int i = 0; i < BENCH_SAMPLE_COUNT; ++i)
+    {
+        if (memcmp((const char*)reference + i * stride, (const char*)result + i * stride, stride) != 0)
+        {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+static void bench_mat4x4_mul(void)
+{
+    double start = bench_now();
+    for (int iteration = 0; iteration < BENCH_ITERATIONS; ++iteration)
+    {
+        for (int i = 0; i < BENCH_SAMPLE_COUNT; ++i)
+        {
+            mat4x4_mul(B.reference[i], B.a[i], B.b[i]);
+        }
+    }
+    double scalar_seconds = bench_now() - start;
+
+    start = bench_now();
+    for (int iteration = 0; iteration < BENCH_ITERATIONS; ++iteration)
+    {
+        for (int i = 0; i < BENCH_SAMPLE_COUNT; ++i)
+        {
+            mat4x4_mul_simd(B.result[i], B.a[i], B.b[i]);
+        }
+    }
+    double simd_seconds = bench_now() - start;
+
+    bench_report("mat4x4_mul", scalar_seconds, simd_seconds, bench_count_mismatches(B.reference, B.result, sizeof(mat4x4)));
+}
+
+static void bench_mat4x4_mul_vec4(void)
+{
+    vec4* reference = (vec4*)B.reference;
+    vec4* result    = (vec4*)B.result;
+
+    double start = bench_now();
+    for (int iteration = 0; iteration < BENCH_ITERATIONS; ++iteration)
+    {
+        for (int i = 0; i < BENCH_SAMPLE_COUNT; ++i)
+        {
+            mat4x4_mul_vec4(reference[i], B.a[i], B.v[i]);
+        }
+    }
+    double scalar_seconds = bench_now() - start;
+
+    start = bench_now();
+    for (int iteration = 0; iteration < BENCH_ITERATIONS; ++iteration)
+    {
+        for (int i = 0; i < BENCH_SAMPLE_COUNT; ++i)
+        {
+            mat4x4_mul_vec4_simd(result[i], B.a[i], B.v[i]);
+        }
+    }
+    double simd_seconds = bench_now() - start;
+
+    bench_report("mat4x4_mul_vec4", scalar_seconds, simd_seconds, bench_count_mismatches(reference, result, sizeof(vec4)));
+}
+
+static void bench_quat_mul(void)
+{
+    quat* reference = (quat*)B.reference;
+    quat* result    = (quat*)B.result;
+
+    double start = bench_now();
+    for (int iteration = 0; iteration < BENCH_ITERATIONS; ++iteration)
+    {
+        for (int i = 0; i < BENCH_SAMPLE_COUNT; ++i)
+        {
+            quat_mul(reference[i], B.p[i], B.q[i]);
+        }
+    }
+    double scalar_seconds = bench_now() - start;
+
+    start = bench_now();
+    for (int iteration = 0; iteration < BENCH_ITERATIONS; ++iteration)
+    {
+        for (int i = 0; i < BENCH_SAMPLE_COUNT; ++i)
+        {
+            quat_mul_simd(result[i], B.p[i], B.q[i]);
+        }
+    }
+    double simd_seconds = bench_now() - start;
+
+    bench_report("quat_mul", scalar_seconds, simd_seconds, bench_count_mismatches(reference, result, sizeof(quat)));
+}
+
+static void bench_mat4x4_mul_affine(void)
+{
+    for (int i = 0; i < BENCH_SAMPLE_COUNT; ++i)
+    {
+        bench_random_affine(B.a[i]);
+        bench_random_affine(B.b[i]);
+    }
+
+    double start = bench_now();
+    for (int iteration = 0; iteration < BENCH_ITERATIONS; ++iteration)
+    {
+        for (int i = 0; i < BENCH_SAMPLE_COUNT; ++i)
+        {
+            mat4x4_mul(B.reference[i], B.a[i], B.b[i]);
+        }
+    }
+    double scalar_seconds = bench_now() - start;
+
+    start = bench_now();
+    for (int iteration = 0; iteration < BENCH_ITERATIONS; ++iteration)
+    {
+        for (int i = 0; i < BENCH_SAMPLE_COUNT; ++i)
+        {
+            mat4x4_mul_affine(B.result[i], B.a[i], B.b[i]);
+        }
+    }
+    double simd_seconds = bench_now() - start;
+
+    int mismatches = 0;
+    for (int i = 0; i < BENCH_SAMPLE_COUNT; ++i)
+    {
+        for (int col = 0; col < 4; ++col)
+        {
+            for (int row = 0; row < 4; ++row)
+            {
+                if (B.reference[i][col][row] != B.result[i][col][row])
+                {
+                    mismatches++;
+                    col = row = 4;
+                }
+            }
+        }
+    }
+
+    bench_report("mat4x4_affine", scalar_seconds, simd_seconds, mismatches);
+}
+
+int main(void)
+{
+    B.a         = (mat4x4*)malloc(sizeof(mat4x4) * BENCH_SAMPLE_COUNT);
+    B.b         = (mat4x4*)malloc(sizeof(mat4x4) * BENCH_SAMPLE_COUNT);
+    B.v         = (vec4*)malloc(sizeof(vec4) * BENCH_SAMPLE_COUNT);
+    B.p         = (quat*)malloc(sizeof(quat) * BENCH_SAMPLE_COUNT);
+    B.q         = (quat*)malloc(sizeof(quat) * BENCH_SAMPLE_COUNT);
+    B.reference = (mat4x4*)malloc(sizeof(mat4x4) * BENCH_SAMPLE_COUNT);
+    B.result    = (mat4x4*)malloc(sizeof(mat4x4) * BENCH_SAMPLE_COUNT);
+    if (!B.a || !B.b || !B.v || !B.p || !B.q || !B.reference || !B.result)
+    {
+        rlog_error("math_simd_bench: out of memory");
+        return -1;
+    }
+
+    srand(4321);
+    for (int i = 0; i < BENCH_SAMPLE_COUNT; ++i)
+    {
+        for (int col = 0; col < 4; ++col)
+        {
+            for (int row = 0; row < 4; ++row)
+            {
+                B.a[i][col][row] = bench_random();
+                B.b[i][col][row] = bench_random();
+            }
+            B.v[i][col] = bench_random();
+            B.p[i][col] = bench_random();
+            B.q[i][col] = bench_random();
+        }
+    }
+
+#if defined(RASTER_SIMD)
+    rlog_info("math_simd_bench: SIMD backend enabled");
+#else
+    rlog_info("math_simd_bench: SIMD backend disabled, both paths are scalar");
+#endif
+
+    bench_mat4x4_mul();
+    bench_mat4x4_mul_vec4();
+    bench_quat_mul();
+    bench_mat4x4_mul_affine();
+
+    free(B.a);
+    free(B.b);
+    free(B.v);
+    free(B.p);
+    free(B.q);
+    free(B.reference);
+    free(B.result);
+
+    return 0;
+}
@@ -0,0 +1,206 @@
+/*
+    sprite_batch_bench - draw-call count and frame time for immediate vs batched sprites
+
+    Renders 1k, 10k and 50k textured sprites, first with one rgfx_sprite_draw per sprite
+    outside a batch and then wrapped in rgfx_batch_begin/rgfx_batch_end, and logs the
+    average frame time and draw calls per frame for each run.
+
+    Frame times include buffer swaps, so disable vsync in the driver when comparing
+    (e.g. vblank_mode=0 on Mesa, __GL_SYNC_TO_VBLANK=0 on NVIDIA).
+*/
+
+#include "raster/raster.h"
+
+#include <stdlib.h>
+
+#define BENCH_WARMUP_FRAMES  30
+#define BENCH_MEASURE_FRAMES 240
+
+static const int k_sprite_counts[] = { 1000, 10000, 50000 };
+#define BENCH_SPRITE_COUNT_STEPS ((int)(sizeof(k_sprite_counts) / sizeof(k_sprite_counts[0])))
+
+typedef enum
+{
+    BENCH_MODE_IMMEDIATE,
+    BENCH_MODE_BATCHED,
+    BENCH_MODE_COUNT
+} bench_mode_t;
+
+static const char* const k_mode_names[BENCH_MODE_COUNT] = { "immediate", "batched" };
+
+typedef struct
+{
+    rgfx_sprite_handle* sprites;
+    int                 sprite_count;
+    int                 step;
+    bench_mode_t        mode;
+    int                 frame;
+    double              frame_time_total;
+    uint64_t            draw_calls_total;
+} bench_state_t;
+
+static bench_state_t B;
+
+static void bench_destroy_sprites(void)
+{
+    for (int i = 0; i < B.sprite_count; ++i)
+    {
+        rgfx_sprite_destroy(B.sprites[i]);
+    }
+    free(B.sprites);
+    B.sprites      = NULL;
+    B.sprite_count = 0;
+}
+
+static bool bench_create_sprites(int count)
+{
+    B.sprites = (rgfx_sprite_handle*)calloc((size_t)count, sizeof(rgfx_sprite_handle));
+    if (!B.sprites)
+    {
+        return false;
+    }
+
+    int   columns = 1;
+    while (columns * columns < count)
+    {
+        columns++;
+    }
+    float extent  = 8.0f;
+    float spacing = extent / (float)columns;
+
+    for (int i = 0; i < count; ++i)
+    {
+        float x = -0.5f * extent + spacing * (float)(i % columns);
+        float y = -0.5f * extent + spacing * (float)(i / columns);
+
+        rgfx_sprite_desc_t desc = { .position     = { x, y, 0.0f },
+                                    .scale        = { spacing * 0.9f, spacing * 0.9f, 1.0f },
+                                    .color        = { 1.0f, (float)(i % 7) / 6.0f, 1.0f },
+                                    .texture_path = "assets/textures/test_texture.png" };
+
+        B.sprites[i] = rgfx_sprite_create(&desc);
+        if (B.sprites[i] == RGFX_INVALID_SPRITE_HANDLE)
+        {
+            rlog_error("sprite_batch_bench: failed to create sprite %d of %d", i, count);
+            B.sprite_count = i;
+            return false;
+        }
+    }
+
+    B.sprite_count = count;
+    return true;
+}
+
+static void bench_start_step(void)
+{
+    int count = k_sprite_counts[B.step];
+    rlog_info("sprite_batch_bench: creating %d sprites", count);
+    if (!bench_create_sprites(count))
+    {
+        rapp_quit();
+        return;
+    }
+
+    B.mode             = BENCH_MODE_IMMEDIATE;
+    B.frame            = 0;
+    B.frame_time_total = 0.0;
+    B.draw_calls_total = 0;
+}
+
+static void bench_update(float dt)
+{
+    if (!B.sprites)
+    {
+        return;
+    }
+
+    B.frame++;
+    if (B.frame > BENCH_WARMUP_FRAMES + 1)
+    {
+        rgfx_frame_stats_t stats;
+        rgfx_get_frame_stats(&stats);
+        B.frame_time_total += dt;
+        B.draw_calls_total += stats.draw_calls;
+    }
+
+    if (B.frame < BENCH_WARMUP_FRAMES + 1 + BENCH_MEASURE_FRAMES)
+    {
+        return;
+    }
+
+    rlog_info("sprite_batch_bench: %6d sprites %-9s  %8.3f ms/frame  %8.1f draw calls/frame",
+              B.sprite_count,
+              k_mode_names[B.mode],
+              1000.0 * B.frame_time_total / BENCH_MEASURE_FRAMES,
+              (double)B.draw_calls_total / BENCH_MEASURE_FRAMES);
+
+    B.frame            = 0;
+    B.frame_time_total = 0.0;
+    B.draw_calls_total = 0;
+
+    if (++B.mode < BENCH_MODE_COUNT)
+    {
+        return;
+    }
+
+    bench_destroy_sprites();
+    if (++B.step < BENCH_SPRITE_COUNT_STEPS)
+    {
+        bench_start_step();
+    }
+    else
+    {
+        rapp_quit();
+    }
+}
+
+static void bench_draw(void)
+{
+    rgfx_clear(0.1f, 0.1f, 0.12f);
+
+    if (B.mode == BENCH_MODE_BATCHED)
+    {
+        rgfx_batch_begin();
+    }
+
+    for (int i = 0; i < B.sprite_count; ++i)
+    {
+        rgfx_sprite_draw(B.sprites[i]);
+    }
+
+    if (B.mode == BENCH_MODE_BATCHED)
+    {
+        rgfx_batch_end();
+    }
+}
+
+static void bench_cleanup(void)
+{
+    bench_destroy_sprites();
+}
+
+int main(void)
+{
+    rapp_desc_t app_desc = { .window     = { .title = "Raster Sprite Batch Benchmark", .width = 1280, .height = 720 },
+                             .update_fn  = bench_update,
+                             .draw_fn    = bench_draw,
+                             .cleanup_fn = bench_cleanup,
+                             .camera     = { .position = { 0.0f, 0.0f, 5.0f },
+                                             .target   = { 0.0f, 0.0f, 0.0f },
+                                             .up       = { 0.0f, 1.0f, 0.0f },
+                                             .fov      = deg_to_rad(90.0f),
+                                             .aspect   = 1280.0f / 720.0f,
+                                             .near     = 0.1f,
+                                             .far      = 100.0f } };
+
+    if (!rapp_init(&app_desc))
+    {
+        rlog_error("Failed to initialize the raster engine");
+        return -1;
+    }
+
+    bench_start_step();
+    rapp_run();
+
+    return 0;
+}
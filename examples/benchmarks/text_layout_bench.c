@@ -0,0 +1,200 @@
+/*
+    text_layout_bench - cost of laying out 1 KB strings through rgfx_text_set_text
+
+    Builds a 1 KB ASCII string and a 1 KB string mixing multi-byte UTF-8, then calls
+    rgfx_text_set_text on one text object BENCH_LAYOUTS_PER_FRAME times per frame and
+    logs the average time per layout. Glyphs are rasterized during warmup, so the measured
+    frames cover measuring, quad building and the vertex upload only.
+*/
+
+#include "raster/raster.h"
+
+#include <string.h>
+#include <time.h>
+
+#define BENCH_WARMUP_FRAMES     10
+#define BENCH_MEASURE_FRAMES    120
+#define BENCH_LAYOUTS_PER_FRAME 64
+#define BENCH_STRING_BYTES      1024
+#define BENCH_LINE_BYTES        72
+
+typedef enum
+{
+    BENCH_STRING_ASCII,
+    BENCH_STRING_UTF8,
+    BENCH_STRING_COUNT
+} bench_string_t;
+
+static const char* const k_string_names[BENCH_STRING_COUNT] = { "ascii", "utf-8" };
+
+static const char* const k_string_sources[BENCH_STRING_COUNT] = {
+    "The quick brown fox jumps over the lazy dog. AV Wa To Ly 0123456789 ",
+    "Gr\xC3\xBC\xC3\x9F" "e, caf\xC3\xA9 na\xC3\xAFve \xE2\x80\x94 \xC3\x85ngstr\xC3\xB6m \xC2\xB1 \xE2\x82\xAC 12,50 ",
+};
+
+typedef struct
+{
+    rgfx_text_handle text;
+    char             strings[2][BENCH_STRING_BYTES + 1];
+    bench_string_t   kind;
+    int              frame;
+    double           layout_seconds;
+    uint32_t         layouts;
+} bench_state_t;
+
+static bench_state_t B;
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Repeats the source up to BENCH_STRING_BYTES without splitting a UTF-8 sequence, breaking lines as it goes */
+static void bench_fill_string(char* out, const char* source, char variant)
+{
+    size_t source_length = strlen(source);
+    size_t length        = 0;
+    size_t column        = 0;
+    size_t cursor        = 0;
+
+    while (length < BENCH_STRING_BYTES)
+    {
+        if (column >= BENCH_LINE_BYTES)
+        {
+            out[length++] = '\n';
+            column        = 0;
+            continue;
+        }
+
+        size_t sequence = 1;
+        while (cursor + sequence < source_length && ((unsigned char)source[cursor + sequence] & 0xC0u) == 0x80u)
+        {
+            sequence++;
+        }
+        if (length + sequence > BENCH_STRING_BYTES)
+        {
+            break;
+        }
+
+        memcpy(out + length, source + cursor, sequence);
+        length += sequence;
+        column += sequence;
+        cursor  = (cursor + sequence) % source_length;
+    }
+
+    // The two buffers differ in their first byte so every call is a real relayout
+    out[0]      = variant;
+    out[length] = '\0';
+}
+
+static void bench_start_kind(void)
+{
+    bench_fill_string(B.strings[0], k_string_sources[B.kind], 'A');
+    bench_fill_string(B.strings[1], k_string_sources[B.kind], 'B');
+
+    B.frame          = 0;
+    B.layout_seconds = 0.0;
+    B.layouts        = 0;
+}
+
+static void bench_update(float dt)
+{
+    (void)dt;
+
+    if (B.text == RGFX_INVALID_TEXT_HANDLE)
+    {
+        return;
+    }
+
+    bool   measuring = B.frame >= BENCH_WARMUP_FRAMES;
+    double start     = bench_now();
+    for (int i = 0; i < BENCH_LAYOUTS_PER_FRAME; ++i)
+    {
+        rgfx_text_set_text(B.text, B.strings[i & 1]);
+    }
+    if (measuring)
+    {
+        B.layout_seconds += bench_now() - start;
+        B.layouts        += BENCH_LAYOUTS_PER_FRAME;
+    }
+
+    if (++B.frame < BENCH_WARMUP_FRAMES + BENCH_MEASURE_FRAMES)
+    {
+        return;
+    }
+
+    double us_per_layout = 1e6 * B.layout_seconds / (double)B.layouts;
+    rlog_info("text_layout_bench: %-5s %4d bytes  %8.2f us/layout  %8.1f MB/s",
+              k_string_names[B.kind],
+              BENCH_STRING_BYTES,
+              us_per_layout,
+              (double)BENCH_STRING_BYTES / us_per_layout);
+
+    if (++B.kind < BENCH_STRING_COUNT)
+    {
+        bench_start_kind();
+    }
+    else
+    {
+        rapp_quit();
+    }
+}
+
+static void bench_draw(void)
+{
+    rgfx_clear(0.1f, 0.1f, 0.12f);
+
+    if (B.text != RGFX_INVALID_TEXT_HANDLE)
+    {
+        rgfx_text_submit(B.text, 0);
+    }
+}
+
+static void bench_cleanup(void)
+{
+    rgfx_text_destroy(B.text);
+    B.text = RGFX_INVALID_TEXT_HANDLE;
+}
+
+int main(void)
+{
+    rapp_desc_t app_desc = { .window     = { .title = "Raster Text Layout Benchmark", .width = 1280, .height = 720 },
+                             .update_fn  = bench_update,
+                             .draw_fn    = bench_draw,
+                             .cleanup_fn = bench_cleanup,
+                             .camera     = { .position = { 0.0f, 0.0f, 5.0f },
+                                             .target   = { 0.0f, 0.0f, 0.0f },
+                                             .up       = { 0.0f, 1.0f, 0.0f },
+                                             .fov      = deg_to_rad(90.0f),
+                                             .aspect   = 1280.0f / 720.0f,
+                                             .near     = 0.1f,
+                                             .far      = 100.0f } };
+
+    if (!rapp_init(&app_desc))
+    {
+        rlog_error("Failed to initialize the raster engine");
+        return -1;
+    }
+
+    B.kind = BENCH_STRING_ASCII;
+    bench_start_kind();
+
+    rgfx_text_desc_t text_desc = { .font_path  = "assets/fonts/roboto.ttf",
+                                   .font_size  = 16.0f,
+                                   .text       = B.strings[0],
+                                   .position   = { 0.0f, 0.0f, 0.0f },
+                                   .text_color = { 1.0f, 1.0f, 1.0f } };
+
+    B.text = rgfx_text_create(&text_desc);
+    if (B.text == RGFX_INVALID_TEXT_HANDLE)
+    {
+        rlog_error("text_layout_bench: failed to create text");
+        return -1;
+    }
+
+    rapp_run();
+
+    return 0;
+}
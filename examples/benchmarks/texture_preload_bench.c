@@ -0,0 +1,153 @@
+/*
+    texture_preload_bench - wall-clock time to load a level's worth of PNGs
+
+    Loads the same BENCH_TEXTURE_COUNT PNGs once with a serial rgfx_load_texture loop and
+    then with rgfx_preload_textures on 1, 2, 4 and 8 decoding threads (the calling thread
+    plus rjob workers), logging the best of BENCH_REPEATS runs for each. The images sit in
+    assets/decode, which is never cooked, so every load is a real stb_image decode.
+*/
+
+#include "raster/raster.h"
+
+#include <time.h>
+
+#define BENCH_TEXTURE_COUNT 48
+#define BENCH_REPEATS       3
+#define BENCH_TEXTURE_PATH  "assets/decode/test_texture.png"
+
+static const uint32_t k_thread_counts[] = { 1, 2, 4, 8 };
+
+static const char*  g_paths[BENCH_TEXTURE_COUNT];
+static unsigned int g_ids[BENCH_TEXTURE_COUNT];
+static bool         g_done = false;
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void bench_delete_textures(void)
+{
+    for (int i = 0; i < BENCH_TEXTURE_COUNT; ++i)
+    {
+        rgfx_delete_texture(g_ids[i]);
+        g_ids[i] = 0;
+    }
+}
+
+static double bench_serial(void)
+{
+    double best = 1e30;
+    for (int run = 0; run < BENCH_REPEATS; ++run)
+    {
+        double start = bench_now();
+        for (int i = 0; i < BENCH_TEXTURE_COUNT; ++i)
+        {
+            g_ids[i] = rgfx_load_texture(g_paths[i]);
+        }
+        double elapsed = bench_now() - start;
+        best           = elapsed < best ? elapsed : best;
+        bench_delete_textures();
+    }
+    return best;
+}
+
+static double bench_preload(uint32_t threads)
+{
+    // The calling thread decodes too, so N threads means N - 1 workers
+    rjob_init(threads - 1u);
+
+    double best = 1e30;
+    for (int run = 0; run < BENCH_REPEATS; ++run)
+    {
+        double   start   = bench_now();
+        uint32_t loaded  = rgfx_preload_textures(g_paths, BENCH_TEXTURE_COUNT, g_ids);
+        double   elapsed = bench_now() - start;
+        best             = elapsed < best ? elapsed : best;
+        bench_delete_textures();
+
+        if (loaded != BENCH_TEXTURE_COUNT)
+        {
+            rlog_warning("texture_preload_bench: only %u of %d textures loaded", loaded, BENCH_TEXTURE_COUNT);
+        }
+    }
+    return best;
+}
+
+static void bench_update(float dt)
+{
+    (void)dt;
+
+    if (g_done)
+    {
+        return;
+    }
+    g_done = true;
+
+    rgfx_texture_stats_t before;
+    rgfx_texture_get_stats(&before);
+
+    // Warm the file cache so the first measured loop does not pay for the disk
+    g_ids[0] = rgfx_load_texture(g_paths[0]);
+    rgfx_delete_texture(g_ids[0]);
+    g_ids[0] = 0;
+
+    double serial = bench_serial();
+    rlog_info("texture_preload_bench: serial    %d textures  %8.2f ms", BENCH_TEXTURE_COUNT, serial * 1e3);
+
+    for (size_t i = 0; i < sizeof(k_thread_counts) / sizeof(k_thread_counts[0]); ++i)
+    {
+        double preload = bench_preload(k_thread_counts[i]);
+        rlog_info("texture_preload_bench: %u thread%s %d textures  %8.2f ms  %5.2fx",
+                  k_thread_counts[i],
+                  k_thread_counts[i] == 1 ? " " : "s",
+                  BENCH_TEXTURE_COUNT,
+                  preload * 1e3,
+                  serial / preload);
+    }
+
+    rgfx_texture_stats_t after;
+    rgfx_texture_get_stats(&after);
+    if (after.cooked_loads != before.cooked_loads)
+    {
+        rlog_warning("texture_preload_bench: some loads used a cooked .rtex, so they measure reads, not decoding");
+    }
+
+    rapp_quit();
+}
+
+static void bench_draw(void)
+{
+    rgfx_clear(0.1f, 0.1f, 0.12f);
+}
+
+int main(void)
+{
+    rapp_desc_t app_desc = { .window    = { .title = "Raster Texture Preload Benchmark", .width = 1280, .height = 720 },
+                             .update_fn = bench_update,
+                             .draw_fn   = bench_draw,
+                             .camera    = { .position = { 0.0f, 0.0f, 5.0f },
+                                            .target   = { 0.0f, 0.0f, 0.0f },
+                                            .up       = { 0.0f, 1.0f, 0.0f },
+                                            .fov      = deg_to_rad(90.0f),
+                                            .aspect   = 1280.0f / 720.0f,
+                                            .near     = 0.1f,
+                                            .far      = 100.0f } };
+
+    if (!rapp_init(&app_desc))
+    {
+        rlog_error("Failed to initialize the raster engine");
+        return -1;
+    }
+
+    for (int i = 0; i < BENCH_TEXTURE_COUNT; ++i)
+    {
+        g_paths[i] = BENCH_TEXTURE_PATH;
+    }
+
+    rapp_run();
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+    transform_compose_bench - cost of building local/world matrices from position, rotation and scale
+
+    Composes BENCH_TRANSFORM_COUNT local matrices the way rtransform_update used to (identity
+    translation and scale matrices, mat4x4_from_quat and two mat4x4_mul) and with
+    mat4x4_compose_trs, then multiplies each by a parent with mat4x4_mul and mat4x4_mul_affine.
+    Logs ns per transform for each path and the largest difference between their results.
+
+    Runs without a window; it only needs the math headers.
+*/
+
+#include "raster/raster.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_TRANSFORM_COUNT 65536
+#define BENCH_ITERATIONS      64
+
+typedef struct
+{
+    vec3*   positions;
+    quat*   rotations;
+    vec3*   scales;
+    mat4x4* locals;
+    mat4x4* reference;
+    mat4x4* worlds;
+    mat4x4  parent;
+} bench_state_t;
+
+static bench_state_t B;
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static float bench_random(float min, float max)
+{
+    return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+static void bench_compose_reference(mat4x4 M, vec3 const t, quat const q, vec3 const s)
+{
+    mat4x4 translation, rotation, scale, temp;
+
+    mat4x4_identity(translation);
+    translation[3][0] = t[0];
+    translation[3][1] = t[1];
+    translation[3][2] = t[2];
+
+    mat4x4_from_quat(rotation, q);
+
+    mat4x4_identity(scale);
+    scale[0][0] = s[0];
+    scale[1][1] = s[1];
+    scale[2][2] = s[2];
+
+    mat4x4_mul(temp, translation, rotation);
+    mat4x4_mul(M, temp, scale);
+}
+
+static float bench_max_difference(mat4x4* a, mat4x4* b)
+{
+    float max_difference = 0.0f;
+    for (int i = 0; i < BENCH_TRANSFORM_COUNT; ++i)
+    {
+        for (int col = 0; col < 4; ++col)
+        {
+            for (int row = 0; row < 4; ++row)
+            {
+                float difference = fabsf(a[i][col][row] - b[i][col][row]);
+                if (difference > max_difference)
+                {
+                    max_difference = difference;
+                }
+            }
+        }
+    }
+    return max_difference;
+}
+
+static void bench_report(const char* name, double seconds, float max_difference)
+{
+    double ns_per_transform = 1e9 * seconds / ((double)BENCH_TRANSFORM_COUNT * BENCH_ITERATIONS);
+    rlog_info("transform_compose_bench: %-16s %8.2f ns/transform  max diff %g", name, ns_per_transform, max_difference);
+}
+
+int main(void)
+{
+    B.positions = (vec3*)malloc(sizeof(vec3) * BENCH_TRANSFORM_COUNT);
+    B.rotations = (quat*)malloc(sizeof(quat) * BENCH_TRANSFORM_COUNT);
+    B.scales    = (vec3*)malloc(sizeof(vec3) * BENCH_TRANSFORM_COUNT);
+    B.locals    = (mat4x4*)malloc(sizeof(mat4x4) * BENCH_TRANSFORM_COUNT);
+    B.reference = (mat4x4*)malloc(sizeof(mat4x4) * BENCH_TRANSFORM_COUNT);
+    B.worlds    = (mat4x4*)malloc(sizeof(mat4x4) * BENCH_TRANSFORM_COUNT);
+    if (!B.positions || !B.rotations || !B.scales || !B.locals || !B.reference || !B.worlds)
+    {
+        rlog_error("transform_compose_bench: out of memory");
+        return -1;
+    }
+
+    srand(1234);
+    for (int i = 0; i < BENCH_TRANSFORM_COUNT; ++i)
+    {
+        vec3 axis = { bench_random(-1.0f, 1.0f), bench_random(-1.0f, 1.0f), bench_random(0.1f, 1.0f) };
+        vec3_norm(axis, axis);
+
+        B.positions[i][0] = bench_random(-100.0f, 100.0f);
+        B.positions[i][1] = bench_random(-100.0f, 100.0f);
+        B.positions[i][2] = bench_random(-100.0f, 100.0f);
+        quat_rotate(B.rotations[i], bench_random(-3.14f, 3.14f), axis);
+        B.scales[i][0] = bench_random(0.5f, 2.0f);
+        B.scales[i][1] = bench_random(0.5f, 2.0f);
+        B.scales[i][2] = bench_random(0.5f, 2.0f);
+    }
+
+    quat parent_rotation;
+    vec3 parent_axis     = { 0.0f, 0.0f, 1.0f };
+    vec3 parent_position = { 5.0f, -3.0f, 1.0f };
+    vec3 parent_scale    = { 2.0f, 2.0f, 1.0f };
+    quat_rotate(parent_rotation, 0.7f, parent_axis);
+    mat4x4_compose_trs(B.parent, parent_position, parent_rotation, parent_scale);
+
+    double start = bench_now();
+    for (int iteration = 0; iteration < BENCH_ITERATIONS; ++iteration)
+    {
+        for (int i = 0; i < BENCH_TRANSFORM_COUNT; ++i)
+        {
+            bench_compose_reference(B.reference[i], B.positions[i], B.rotations[i], B.scales[i]);
+        }
+    }
+    bench_report("compose mul", bench_now() - start, 0.0f);
+
+    start = bench_now();
+    for (int iteration = 0; iteration < BENCH_ITERATIONS; ++iteration)
+    {
+        for (int i = 0; i < BENCH_TRANSFORM_COUNT; ++i)
+        {
+            mat4x4_compose_trs(B.locals[i], B.positions[i], B.rotations[i], B.scales[i]);
+        }
+    }
+    bench_report("compose trs", bench_now() - start, bench_max_difference(B.locals, B.reference));
+
+    start = bench_now();
+    for (int iteration = 0; iteration < BENCH_ITERATIONS; ++iteration)
+    {
+        for (int i = 0; i < BENCH_TRANSFORM_COUNT; ++i)
+        {
+            mat4x4_mul(B.reference[i], B.parent, B.locals[i]);
+        }
+    }
+    bench_report("parent mul", bench_now() - start, 0.0f);
+
+    start = bench_now();
+    for (int iteration = 0; iteration < BENCH_ITERATIONS; ++iteration)
+    {
+        for (int i = 0; i < BENCH_TRANSFORM_COUNT; ++i)
+        {
+            mat4x4_mul_affine(B.worlds[i], B.parent, B.locals[i]);
+        }
+    }
+    bench_report("parent affine", bench_now() - start, bench_max_difference(B.worlds, B.reference));
+
+    free(B.positions);
+    free(B.rotations);
+    free(B.scales);
+    free(B.locals);
+    free(B.reference);
+    free(B.worlds);
+
+    return 0;
+}
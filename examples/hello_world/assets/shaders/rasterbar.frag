@@ -4,10 +4,19 @@ in vec2 TexCoord;
 uniform sampler2D uTexture;
 uniform vec3 uColor;
 uniform bool uUseTexture;
-uniform float uTime;
 uniform float uFrequency;
 uniform float uAmplitude;
 
+layout (std140) uniform RasterFrame
+{
+    highp mat4 uView;
+    highp mat4 uProjection;
+    highp mat4 uViewProjection;
+    highp float uTime;
+    highp float uDeltaTime;
+    highp vec2 uViewportSize;
+};
+
 void main()
 {
     float yPos = TexCoord.y;
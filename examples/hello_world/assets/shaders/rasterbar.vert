@@ -5,13 +5,20 @@ out vec2 TexCoord;
 
 uniform vec3 uPosition;
 uniform vec2 uSize;
-uniform mat4 uView;
-uniform mat4 uProjection;
-uniform float uTime;
+
+layout (std140) uniform RasterFrame
+{
+    highp mat4 uView;
+    highp mat4 uProjection;
+    highp mat4 uViewProjection;
+    highp float uTime;
+    highp float uDeltaTime;
+    highp vec2 uViewportSize;
+};
 
 void main()
 {
     vec3 pos3d = vec3(aPos * uSize, 0.0) + uPosition;
-    gl_Position = uProjection * uView * vec4(pos3d, 1.0);
+    gl_Position = uViewProjection * vec4(pos3d, 1.0);
     TexCoord = aTexCoord;
 }
\ No newline at end of file
@@ -81,10 +81,10 @@ void game_draw(void)
     color bg_color = { 0.0f, 0.53f, 0.94f };
     rgfx_clear_color(bg_color);
 
-    rgfx_sprite_draw(G.sprite_rasterbar);
-    rgfx_sprite_draw(G.sprite_one);
-    rgfx_sprite_draw(G.sprite_two);
-    rgfx_text_draw(G.text);
+    rgfx_sprite_submit(G.sprite_rasterbar, 0);
+    rgfx_sprite_submit(G.sprite_one, 1);
+    rgfx_sprite_submit(G.sprite_two, 1);
+    rgfx_text_submit(G.text, 1);
 }
 
 void game_cleanup(void)
@@ -152,13 +152,26 @@ int main(void)
         }
     }
 
+    // Pack the googly textures into one atlas so both sprites share a texture
+    const char*       googly_paths[] = { "assets/textures/googly-a.png", "assets/textures/googly-b.png", "assets/textures/googly-e.png" };
+    rgfx_atlas_desc_t atlas_desc     = { .paths = googly_paths, .path_count = 3 };
+    rgfx_atlas_handle googly_atlas   = rgfx_atlas_create(&atlas_desc);
+    if (googly_atlas != RGFX_INVALID_ATLAS_HANDLE)
+    {
+        rgfx_atlas_stats_t atlas_stats;
+        rgfx_atlas_get_stats(googly_atlas, &atlas_stats);
+        rlog_info("Googly atlas: %u regions on %u page(s), %.1f%% used", atlas_stats.region_count, atlas_stats.page_count, atlas_stats.efficiency * 100.0f);
+    }
+
     // Create sprites
     rgfx_sprite_desc_t sprite_desc = { .position             = { 0.0f, 0.0f, 0.0f },
                                        .scale                = { 1.0f, 1.0f, 1.0f },
                                        .color                = { 1.0f, 1.0f, 1.0f },
                                        .vertex_shader_path   = "assets/shaders/basic_texture.vert",
                                        .fragment_shader_path = "assets/shaders/basic_texture.frag",
-                                       .texture_path         = "assets/textures/googly-a.png" };
+                                       .texture_path         = "assets/textures/googly-a.png",
+                                       .atlas                = googly_atlas,
+                                       .atlas_region         = "assets/textures/googly-a.png" };
 
     G.sprite_one = rgfx_sprite_create(&sprite_desc);
     if (G.sprite_one == RGFX_INVALID_SPRITE_HANDLE)
@@ -172,7 +185,9 @@ int main(void)
                                            .color                = { 1.0f, 1.0f, 1.0f },
                                            .vertex_shader_path   = "assets/shaders/basic_texture.vert",
                                            .fragment_shader_path = "assets/shaders/basic_texture.frag",
-                                           .texture_path         = "assets/textures/googly-e.png" };
+                                           .texture_path         = "assets/textures/googly-e.png",
+                                           .atlas                = googly_atlas,
+                                           .atlas_region         = "assets/textures/googly-e.png" };
 
     G.sprite_two = rgfx_sprite_create(&sprite_two_desc);
     if (G.sprite_two == RGFX_INVALID_SPRITE_HANDLE)
@@ -181,6 +196,9 @@ int main(void)
         return -1;
     }
 
+    // The sprites hold their own references to the atlas
+    rgfx_atlas_release(googly_atlas);
+
     rgfx_sprite_set_parent(G.sprite_two, G.sprite_one);
 
     rgfx_sprite_desc_t rasterbar_desc = {
@@ -17,8 +17,10 @@ extern "C"
 
 #include "raster_math.h"
 #include "raster_app.h"
+#include "raster_asset.h"
 #include "raster_gfx.h"
 #include "raster_input.h"
+#include "raster_job.h"
 #include "raster_log.h"
 #include "raster_sfx.h"
 
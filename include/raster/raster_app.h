@@ -28,7 +28,9 @@ extern "C"
         rapp_update_fn     update_fn;
         rapp_draw_fn       draw_fn;
         rapp_cleanup_fn    cleanup_fn;
-        rgfx_camera_desc_t camera; // Default camera configuration
+        rgfx_camera_desc_t camera;           // Default camera configuration
+        const char*        asset_pack;       // Mounted at init; NULL tries RASSET_DEFAULT_PACK
+        float              upload_budget_ms; // Per-frame time for finishing async loads; 0 picks 2
     } rapp_desc_t;
 
     // App lifecycle
@@ -0,0 +1,39 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+    /* Read-only bytes of one asset. Views into the mounted pack point straight at the mapped
+       file and stay valid until rasset_unmount; views of loose files own a heap copy. Either
+       way data[size] is 0, so text assets can be used as C strings in place. */
+    typedef struct
+    {
+        const unsigned char* data;
+        size_t               size;
+        void*                owned; /* heap copy to free on close, NULL for pack views */
+    } rasset_view_t;
+
+#define RASSET_DEFAULT_PACK "assets.rpak"
+
+    /* Maps an asset pack built by tools/asset_pack. Paths found in it are then served from
+       the mapping; anything else still comes from the file system. Returns false, without
+       logging an error, when the file does not exist. */
+    bool rasset_mount(const char* pack_path);
+    /* Every pack view and anything built on one (fonts, sounds) must be gone by now */
+    void rasset_unmount(void);
+    bool rasset_is_mounted(void);
+
+    /* Looks in the mounted pack only; never touches the disk and needs no close */
+    bool rasset_find(const char* path, rasset_view_t* out_view);
+    /* Pack first, then a single read of the loose file */
+    bool rasset_open(const char* path, rasset_view_t* out_view);
+    void rasset_close(rasset_view_t* view);
+
+#ifdef __cplusplus
+}
+#endif
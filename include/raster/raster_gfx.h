@@ -5,6 +5,7 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "linmath.h"
@@ -22,6 +23,27 @@ extern "C" {
     void rgfx_clear(float r, float g, float b);
     void rgfx_clear_color(color color);
 
+    typedef struct {
+        uint32_t draw_calls;
+        uint32_t instanced_draw_calls;
+        uint32_t sprites_drawn;
+        uint32_t texts_drawn;
+        uint32_t state_changes;
+        uint32_t redundant_state_changes_skipped;
+        uint32_t texture_binds;
+    } rgfx_frame_stats_t;
+
+    void rgfx_begin_frame(void);
+    void rgfx_end_frame(void);
+    void rgfx_get_frame_stats(rgfx_frame_stats_t* out_stats);
+
+    /* Sprites drawn between begin/end are grouped by shader program and texture
+       and issued as instanced draws when the program reads aInstanceModel. Translucent
+       sprites are drawn after the opaque ones in the order they were drawn, merging only
+       neighbours that share state. */
+    void rgfx_batch_begin(void);
+    void rgfx_batch_end(void);
+
     typedef uint32_t rgfx_sprite_handle;
     typedef uint32_t rgfx_text_handle;
 
@@ -36,9 +58,70 @@ extern "C" {
 
     char*        rgfx_load_shader_source(const char* filepath);
     unsigned int rgfx_create_shader_program(const char* vertexSource, const char* fragmentSource);
+    void         rgfx_delete_shader_program(unsigned int program);
 
     unsigned int rgfx_load_texture(const char* filepath);
     void         rgfx_delete_texture(unsigned int textureID);
+    /* rgfx_load_texture for a whole list: every file is read and decoded in parallel on the
+       job pool, then uploaded in one pass on this thread. out_ids[i] is 0 where paths[i]
+       failed; returns how many loaded. All decoded images are held until the upload pass. */
+    uint32_t     rgfx_preload_textures(const char* const* paths, uint32_t count, unsigned int* out_ids);
+
+    typedef uint32_t rgfx_texture_handle;
+
+#define RGFX_INVALID_TEXTURE_HANDLE 0u
+
+    typedef struct {
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t textures_resident;
+        size_t   bytes_resident;
+        uint32_t cooked_loads; /* loads served from a .rtex instead of decoding the image */
+    } rgfx_texture_stats_t;
+
+    /* Path-keyed, refcounted texture cache: acquiring an already loaded path returns
+       the same texture without decoding the file again. Both this and rgfx_load_texture
+       prefer a cooked "<name>.rtex" next to the image (see tools/texture_cook). */
+    rgfx_texture_handle rgfx_texture_acquire(const char* filepath);
+    void                rgfx_texture_release(rgfx_texture_handle texture);
+    unsigned int        rgfx_texture_get_id(rgfx_texture_handle texture);
+    void                rgfx_texture_get_stats(rgfx_texture_stats_t* out_stats);
+
+    /* Returns at once with a texture showing a 1x1 white placeholder; the file is read and
+       decoded on a worker and uploaded into the same texture id by rapp's per-frame upload
+       queue. Sprites drawing it pick up the real image, and its alpha, when it lands; a file
+       that fails to load logs an error and keeps the placeholder. rgfx_texture_acquire on a
+       path still loading this way finishes the load before returning. is_ready is false while
+       loading and after a failure, like rsfx_is_sound_ready. */
+    rgfx_texture_handle rgfx_texture_acquire_async(const char* filepath);
+    bool                rgfx_texture_is_ready(rgfx_texture_handle texture);
+
+    typedef uint32_t rgfx_atlas_handle;
+
+#define RGFX_INVALID_ATLAS_HANDLE 0u
+
+    typedef struct {
+        const char* const* paths;      /* each image becomes a region named by its path */
+        uint32_t           path_count;
+        int                page_size;  /* square page edge in pixels; 0 picks 2048 */
+        int                padding;    /* border repeated around each region; 0 picks 2. Pages get
+                                          floor(log2(padding)) mip levels beyond the base */
+    } rgfx_atlas_desc_t;
+
+    typedef struct {
+        uint32_t page_count;
+        uint32_t page_size;
+        uint32_t region_count;
+        size_t   pixels_used;
+        size_t   pixels_total;
+        float    efficiency; /* pixels_used / pixels_total */
+    } rgfx_atlas_stats_t;
+
+    /* Packs many small images into one or more RGBA pages so sprites that use them share a
+       texture, and so a batch, instead of binding one texture each. */
+    rgfx_atlas_handle rgfx_atlas_create(const rgfx_atlas_desc_t* desc);
+    void              rgfx_atlas_release(rgfx_atlas_handle atlas);
+    void              rgfx_atlas_get_stats(rgfx_atlas_handle atlas, rgfx_atlas_stats_t* out_stats);
 
     typedef enum {
         RGFX_UNIFORM_FLOAT,
@@ -71,6 +154,8 @@ extern "C" {
         const char* texture_path;
         rgfx_uniform_t uniforms[RGFX_MAX_UNIFORMS];
         int            uniform_count;
+        rgfx_atlas_handle atlas;        /* with atlas_region, preferred over texture_path */
+        const char*       atlas_region;
     } rgfx_sprite_desc_t;
 
     typedef struct {
@@ -81,6 +166,7 @@ extern "C" {
         color       text_color;
         float       line_spacing;
         int         alignment;
+        bool        sdf; /* distance-field glyphs: one atlas serves every size and zoom level */
     } rgfx_text_desc_t;
 
     typedef enum {
@@ -98,6 +184,18 @@ extern "C" {
     void             rgfx_text_draw(rgfx_text_handle text);
     bool             rgfx_text_update_bitmap(rgfx_text_handle text);
 
+    /* Non-blocking variants: the handle is usable at once and the file work happens on a
+       worker. A sprite draws its placeholder texture and a text draws nothing until ready. */
+    rgfx_sprite_handle rgfx_sprite_create_async(const rgfx_sprite_desc_t* desc);
+    bool               rgfx_sprite_is_ready(rgfx_sprite_handle sprite);
+    rgfx_text_handle   rgfx_text_create_async(const rgfx_text_desc_t* desc);
+    bool               rgfx_text_is_ready(rgfx_text_handle text);
+
+    /* Submitted objects are drawn at rgfx_end_frame in sort-key order: by layer (lowest first),
+       then opaque objects grouped by program and texture, then translucent ones back to front. */
+    void rgfx_sprite_submit(rgfx_sprite_handle sprite, uint8_t layer);
+    void rgfx_text_submit(rgfx_text_handle text, uint8_t layer);
+
     void rgfx_sprite_set_position(rgfx_sprite_handle sprite, vec3 position);
     void rgfx_sprite_set_size(rgfx_sprite_handle sprite, vec2 size);
     void rgfx_sprite_set_color(rgfx_sprite_handle sprite, color color);
@@ -134,6 +232,10 @@ extern "C" {
     void rgfx_sprite_set_rotation(rgfx_sprite_handle sprite, float rotation);
     void rgfx_sprite_get_world_position(rgfx_sprite_handle sprite, vec3 out_position);
 
+    /* Bulk setters: positions are packed xyz triples, rotations one Z angle per sprite */
+    void rgfx_sprite_set_positions(const rgfx_sprite_handle* sprites, const float* positions, uint32_t count);
+    void rgfx_sprite_set_rotations(const rgfx_sprite_handle* sprites, const float* rotations, uint32_t count);
+
     void rgfx_text_set_rotation(rgfx_text_handle text, float rotation);
     void rgfx_text_get_world_position(rgfx_text_handle text, vec3 out_position);
 
@@ -0,0 +1,49 @@
+#pragma once
+
+/*
+    raster_job - worker pool behind asynchronous asset loading
+
+    A job's work function runs on a worker thread and must not touch GL or engine objects;
+    its complete function then runs on the main thread inside rjob_pump, which is where
+    uploads and handle bookkeeping happen. Without threads (e.g. a web build compiled without
+    pthreads) the pool has no workers and rjob_pump runs both halves under the same budget.
+*/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+    typedef void (*rjob_fn)(void* user);
+    typedef void (*rjob_index_fn)(void* user, uint32_t index);
+
+/* One less than the number of cores */
+#define RJOB_DEFAULT_THREADS UINT32_MAX
+
+    /* Starts thread_count workers, replacing any running pool once its jobs finish. 0 runs
+       every job on the calling thread. rjob_submit starts a default pool on first use, so
+       calling this is only needed to choose the size. */
+    bool     rjob_init(uint32_t thread_count);
+    /* Finishes every submitted job, completions included, and stops the workers */
+    void     rjob_shutdown(void);
+    uint32_t rjob_thread_count(void);
+
+    /* complete may be NULL for work with nothing to hand back to the main thread */
+    bool rjob_submit(rjob_fn work, rjob_fn complete, void* user);
+    /* Runs finished jobs' completions until budget_seconds has passed (always at least one).
+       Returns how many completions ran. */
+    uint32_t rjob_pump(double budget_seconds);
+    /* Jobs submitted but not yet completed */
+    uint32_t rjob_pending(void);
+
+    /* Calls fn(user, i) for every i below count, spread over the workers and the calling
+       thread, and returns when all calls are done. fn has the same limits as a job's work.
+       Call from the main thread only; a worker waiting on other workers could deadlock. */
+    void rjob_parallel_for(uint32_t count, rjob_index_fn fn, void* user);
+
+#ifdef __cplusplus
+}
+#endif
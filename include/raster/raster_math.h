@@ -16,6 +16,60 @@ extern "C"
 #include <math.h>
 #include "linmath.h"
 
+/*
+    Optional SIMD backend, enabled with the RASTER_MATH_SIMD CMake option. The *_simd
+    functions below keep linmath's operation order so their results are bit-identical to
+    the scalar versions; without a supported instruction set they are the scalar code.
+*/
+#if defined(RASTER_MATH_SIMD)
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define RASTER_SIMD_WASM
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RASTER_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RASTER_SIMD_NEON
+#endif
+#endif
+
+#if defined(RASTER_SIMD_WASM)
+    typedef v128_t rsimd_f4;
+#define rsimd_load(p)     wasm_v128_load(p)
+#define rsimd_store(p, v) wasm_v128_store((p), (v))
+#define rsimd_splat(x)    wasm_f32x4_splat(x)
+#define rsimd_add(a, b)   wasm_f32x4_add((a), (b))
+#define rsimd_sub(a, b)   wasm_f32x4_sub((a), (b))
+#define rsimd_mul(a, b)   wasm_f32x4_mul((a), (b))
+#define rsimd_yzxw(v)     wasm_i32x4_shuffle((v), (v), 1, 2, 0, 3)
+#define rsimd_zxyw(v)     wasm_i32x4_shuffle((v), (v), 2, 0, 1, 3)
+#define RASTER_SIMD
+#elif defined(RASTER_SIMD_SSE2)
+    typedef __m128 rsimd_f4;
+#define rsimd_load(p)     _mm_loadu_ps(p)
+#define rsimd_store(p, v) _mm_storeu_ps((p), (v))
+#define rsimd_splat(x)    _mm_set1_ps(x)
+#define rsimd_add(a, b)   _mm_add_ps((a), (b))
+#define rsimd_sub(a, b)   _mm_sub_ps((a), (b))
+#define rsimd_mul(a, b)   _mm_mul_ps((a), (b))
+#define rsimd_yzxw(v)     _mm_shuffle_ps((v), (v), _MM_SHUFFLE(3, 0, 2, 1))
+#define rsimd_zxyw(v)     _mm_shuffle_ps((v), (v), _MM_SHUFFLE(3, 1, 0, 2))
+#define RASTER_SIMD
+#elif defined(RASTER_SIMD_NEON)
+    typedef float32x4_t rsimd_f4;
+#define rsimd_load(p)     vld1q_f32(p)
+#define rsimd_store(p, v) vst1q_f32((p), (v))
+#define rsimd_splat(x)    vdupq_n_f32(x)
+#define rsimd_add(a, b)   vaddq_f32((a), (b))
+#define rsimd_sub(a, b)   vsubq_f32((a), (b))
+#define rsimd_mul(a, b)   vmulq_f32((a), (b)) /* not vmlaq: a fused multiply-add would round differently */
+/* Lane 3 of the NEON swizzles is unspecified; callers only use lanes 0-2 */
+#define rsimd_yzxw(v)     vsetq_lane_f32(vgetq_lane_f32((v), 0), vextq_f32((v), (v), 1), 2)
+#define rsimd_zxyw(v)     vsetq_lane_f32(vgetq_lane_f32((v), 2), vextq_f32((v), (v), 3), 0)
+#define RASTER_SIMD
+#endif
+
     typedef struct
     {
         float r;
@@ -118,6 +172,136 @@ extern "C"
         return value;
     }
 
+    // Writes translation * rotation(q) * scale straight into M, matching the result of
+    // composing mat4x4_from_quat with translation and scale matrices through mat4x4_mul
+    static inline void mat4x4_compose_trs(mat4x4 M, vec3 const t, quat const q, vec3 const s)
+    {
+        float a  = q[3];
+        float b  = q[0];
+        float c  = q[1];
+        float d  = q[2];
+        float a2 = a * a;
+        float b2 = b * b;
+        float c2 = c * c;
+        float d2 = d * d;
+
+        M[0][0] = (a2 + b2 - c2 - d2) * s[0];
+        M[0][1] = 2.0f * (b * c + a * d) * s[0];
+        M[0][2] = 2.0f * (b * d - a * c) * s[0];
+        M[0][3] = 0.0f;
+
+        M[1][0] = 2.0f * (b * c - a * d) * s[1];
+        M[1][1] = (a2 - b2 + c2 - d2) * s[1];
+        M[1][2] = 2.0f * (c * d + a * b) * s[1];
+        M[1][3] = 0.0f;
+
+        M[2][0] = 2.0f * (b * d + a * c) * s[2];
+        M[2][1] = 2.0f * (c * d - a * b) * s[2];
+        M[2][2] = (a2 - b2 - c2 + d2) * s[2];
+        M[2][3] = 0.0f;
+
+        M[3][0] = t[0];
+        M[3][1] = t[1];
+        M[3][2] = t[2];
+        M[3][3] = 1.0f;
+    }
+
+    // mat4x4_mul for two affine matrices (last row 0 0 0 1): the last row of b is known,
+    // so each column needs three multiply-adds instead of four. M may alias a or b.
+    static inline void mat4x4_mul_affine(mat4x4 M, mat4x4 const a, mat4x4 const b)
+    {
+#if defined(RASTER_SIMD)
+        rsimd_f4 a0 = rsimd_load(a[0]);
+        rsimd_f4 a1 = rsimd_load(a[1]);
+        rsimd_f4 a2 = rsimd_load(a[2]);
+        rsimd_f4 a3 = rsimd_load(a[3]);
+        rsimd_f4 columns[4];
+        for (int col = 0; col < 4; ++col)
+        {
+            rsimd_f4 sum = rsimd_mul(a0, rsimd_splat(b[col][0]));
+            sum          = rsimd_add(sum, rsimd_mul(a1, rsimd_splat(b[col][1])));
+            columns[col] = rsimd_add(sum, rsimd_mul(a2, rsimd_splat(b[col][2])));
+        }
+        columns[3] = rsimd_add(columns[3], a3);
+        for (int col = 0; col < 4; ++col)
+        {
+            rsimd_store(M[col], columns[col]);
+        }
+#else
+        mat4x4 temp;
+        for (int col = 0; col < 4; ++col)
+        {
+            for (int row = 0; row < 4; ++row)
+            {
+                temp[col][row] = a[0][row] * b[col][0] + a[1][row] * b[col][1] + a[2][row] * b[col][2];
+            }
+        }
+        for (int row = 0; row < 4; ++row)
+        {
+            temp[3][row] += a[3][row];
+        }
+        mat4x4_dup(M, temp);
+#endif
+    }
+
+    // linmath's mat4x4_mul, one column per vector. M may alias a or b.
+    static inline void mat4x4_mul_simd(mat4x4 M, mat4x4 const a, mat4x4 const b)
+    {
+#if defined(RASTER_SIMD)
+        rsimd_f4 a0 = rsimd_load(a[0]);
+        rsimd_f4 a1 = rsimd_load(a[1]);
+        rsimd_f4 a2 = rsimd_load(a[2]);
+        rsimd_f4 a3 = rsimd_load(a[3]);
+        rsimd_f4 columns[4];
+        for (int col = 0; col < 4; ++col)
+        {
+            // Starting from zero matches linmath's accumulator, including the sign of zero results
+            rsimd_f4 sum = rsimd_add(rsimd_splat(0.0f), rsimd_mul(a0, rsimd_splat(b[col][0])));
+            sum          = rsimd_add(sum, rsimd_mul(a1, rsimd_splat(b[col][1])));
+            sum          = rsimd_add(sum, rsimd_mul(a2, rsimd_splat(b[col][2])));
+            columns[col] = rsimd_add(sum, rsimd_mul(a3, rsimd_splat(b[col][3])));
+        }
+        for (int col = 0; col < 4; ++col)
+        {
+            rsimd_store(M[col], columns[col]);
+        }
+#else
+        mat4x4_mul(M, a, b);
+#endif
+    }
+
+    // linmath's mat4x4_mul_vec4. r must not alias v.
+    static inline void mat4x4_mul_vec4_simd(vec4 r, mat4x4 const M, vec4 const v)
+    {
+#if defined(RASTER_SIMD)
+        rsimd_f4 sum = rsimd_add(rsimd_splat(0.0f), rsimd_mul(rsimd_load(M[0]), rsimd_splat(v[0])));
+        sum          = rsimd_add(sum, rsimd_mul(rsimd_load(M[1]), rsimd_splat(v[1])));
+        sum          = rsimd_add(sum, rsimd_mul(rsimd_load(M[2]), rsimd_splat(v[2])));
+        sum          = rsimd_add(sum, rsimd_mul(rsimd_load(M[3]), rsimd_splat(v[3])));
+        rsimd_store(r, sum);
+#else
+        mat4x4_mul_vec4(r, M, v);
+#endif
+    }
+
+    // linmath's quat_mul: the vector part runs four lanes wide, w stays scalar
+    static inline void quat_mul_simd(quat r, quat const p, quat const q)
+    {
+#if defined(RASTER_SIMD)
+        rsimd_f4 vp = rsimd_load(p);
+        rsimd_f4 vq = rsimd_load(q);
+        float    w  = p[3] * q[3] - (((0.0f + p[0] * q[0]) + p[1] * q[1]) + p[2] * q[2]);
+
+        rsimd_f4 cross = rsimd_sub(rsimd_mul(rsimd_yzxw(vp), rsimd_zxyw(vq)), rsimd_mul(rsimd_zxyw(vp), rsimd_yzxw(vq)));
+        cross          = rsimd_add(cross, rsimd_mul(vp, rsimd_splat(q[3])));
+        cross          = rsimd_add(cross, rsimd_mul(vq, rsimd_splat(p[3])));
+        rsimd_store(r, cross);
+        r[3] = w;
+#else
+        quat_mul(r, p, q);
+#endif
+    }
+
     // For compatibility with engine code
     typedef color_t      color;
     typedef color_rgba_t color_a; // Renamed to avoid conflict with the function
@@ -28,7 +28,9 @@ extern "C"
     bool rsfx_init(void);
 
     /**
-     * @brief Terminate the audio system
+     * @brief Terminate the audio system, stopping and freeing every sound
+     *
+     * rapp_shutdown calls this before unmapping the asset pack; calling it again is harmless.
      */
     void rsfx_terminate(void);
 
@@ -39,6 +41,21 @@ extern "C"
      */
     rsfx_sound_handle rsfx_load_sound(const char* path);
 
+    /**
+     * @brief Load a sound without blocking on file I/O or decoder setup
+     * @param path Path to the sound file
+     * @return Handle that is usable at once; playing it before it is ready starts playback
+     *         when the load completes (see rsfx_is_sound_ready)
+     */
+    rsfx_sound_handle rsfx_load_sound_async(const char* path);
+
+    /**
+     * @brief Check whether an asynchronously loaded sound can play
+     * @param sound Handle to the sound
+     * @return true once the sound is loaded, false while loading or if loading failed
+     */
+    bool rsfx_is_sound_ready(rsfx_sound_handle sound);
+
     /**
      * @brief Free a loaded sound
      * @param sound Handle to the sound to free
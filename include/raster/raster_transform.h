@@ -5,15 +5,10 @@ extern "C" {
 #endif
 
 #include "raster_math.h"
+#include <stdint.h>
 
-typedef struct rtransform {
-    vec3 position;
-    vec3 scale;
-    quat rotation;
-    mat4x4 local;
-    mat4x4 world;
-    struct rtransform* parent;
-} rtransform_t;
+// Transforms live in a shared pool; the handle stays valid until rtransform_destroy.
+typedef struct rtransform rtransform_t;
 
 rtransform_t* rtransform_create(void);
 void rtransform_destroy(rtransform_t* transform);
@@ -23,8 +18,20 @@ void rtransform_set_scale(rtransform_t* transform, vec3 scale);
 void rtransform_set_rotation_axis_angle(rtransform_t* transform, vec3 axis, float angle);
 void rtransform_set_rotation_quat(rtransform_t* transform, quat rotation);
 void rtransform_get_world_position(rtransform_t* transform, vec3 out_position);
+void rtransform_get_world_matrix(rtransform_t* transform, mat4x4 out_world);
+
+// Bulk setters over packed arrays: 3 floats per position, 4 per quaternion, 1 angle per
+// Z rotation. NULL entries in transforms are skipped along with their values.
+void rtransform_set_positions(rtransform_t* const* transforms, const float* positions, uint32_t count);
+void rtransform_set_rotations_quat(rtransform_t* const* transforms, const float* rotations, uint32_t count);
+void rtransform_set_rotations_z(rtransform_t* const* transforms, const float* angles, uint32_t count);
+
+// Brings one transform and its ancestors up to date
 void rtransform_update(rtransform_t* transform);
+// Updates every dirty subtree in one pass over the pool, parents before children
+void rtransform_update_all(void);
+void rtransform_shutdown(void);
 
 #ifdef __cplusplus
 }
-#endif
\ No newline at end of file
+#endif
@@ -1,6 +1,9 @@
 #include "raster/raster_app.h"
+#include "raster/raster_asset.h"
 #include "raster/raster_gfx.h"
+#include "raster/raster_job.h"
 #include "raster/raster_log.h"
+#include "raster/raster_sfx.h"
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <stdio.h>
@@ -34,6 +37,9 @@ static struct
     // Camera
     rgfx_camera_t* main_camera;
 
+    // Main-thread time per frame for finishing asynchronous loads
+    double upload_budget;
+
     // Quit flag
     bool should_quit;
  } engine_state = { 0 };
@@ -50,15 +56,19 @@ void emscripten_main_loop(void)
     _rinput_update();
     glfwPollEvents();
 
+    rjob_pump(engine_state.upload_budget);
+
     if (engine_state.update_callback)
     {
         engine_state.update_callback(engine_state.deltaTime);
     }
 
+    rgfx_begin_frame();
     if (engine_state.draw_callback)
     {
         engine_state.draw_callback();
     }
+    rgfx_end_frame();
 
     if (engine_state.window)
     {
@@ -75,7 +85,8 @@ void emscripten_main_loop(void)
             engine_state.cleanup_callback();
         }
 
-        rgfx_shutdown();
+        // Same teardown as the desktop loop so the two cannot drift apart
+        rapp_shutdown();
     }
 }
 #endif
@@ -121,10 +132,14 @@ bool rapp_init(const rapp_desc_t* desc)
     // Make OpenGL context current
     glfwMakeContextCurrent(engine_state.window);
 
+    // Serve assets from the pack when there is one; loose files are the fallback either way
+    rasset_mount(desc->asset_pack ? desc->asset_pack : RASSET_DEFAULT_PACK);
+
     // Initialize graphics subsystem
     if (!rgfx_init())
     {
         rlog_fatal("Failed to initialize graphics system\n");
+        rasset_unmount();
         glfwDestroyWindow(engine_state.window);
         glfwTerminate();
         return false;
@@ -136,6 +151,7 @@ bool rapp_init(const rapp_desc_t* desc)
     {
         rlog_fatal("Failed to create main camera\n");
         rgfx_shutdown();
+        rasset_unmount();
         glfwTerminate();
         return false;
     }
@@ -164,6 +180,8 @@ bool rapp_init(const rapp_desc_t* desc)
     engine_state.draw_callback    = desc->draw_fn;
     engine_state.cleanup_callback = desc->cleanup_fn;
 
+    engine_state.upload_budget = (desc->upload_budget_ms > 0.0f ? desc->upload_budget_ms : 2.0f) * 0.001;
+
     // Initialize quit flag
     engine_state.should_quit = false;
 
@@ -188,15 +206,20 @@ void rapp_run(void)
         _rinput_update();
         glfwPollEvents();
 
+        // Hand finished async loads to GL before the game looks at its handles
+        rjob_pump(engine_state.upload_budget);
+
         if (engine_state.update_callback)
         {
             engine_state.update_callback(engine_state.deltaTime);
         }
 
+        rgfx_begin_frame();
         if (engine_state.draw_callback)
         {
             engine_state.draw_callback();
         }
+        rgfx_end_frame();
 
         if (engine_state.window)
         {
@@ -224,6 +247,9 @@ void rapp_quit(void)
 
 void rapp_shutdown(void)
 {
+    // Outstanding loads complete while everything they upload into still exists
+    rjob_shutdown();
+
     // Cleanup camera
     if (engine_state.main_camera)
     {
@@ -234,6 +260,13 @@ void rapp_shutdown(void)
     // Shutdown graphics subsystem
     rgfx_shutdown();
 
+    // Graphics objects own transforms, so the pool goes after them
+    rtransform_shutdown();
+
+    // Sounds and fonts read the pack in place, so the audio devices stop before it is unmapped
+    rsfx_terminate();
+    rasset_unmount();
+
     // Destroy window and terminate GLFW
     if (engine_state.window)
     {
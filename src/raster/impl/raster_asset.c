@@ -0,0 +1,338 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "raster/raster_asset.h"
+#include "raster/raster_log.h"
+#include "raster_asset_rpak.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define RASSET_MMAP
+#endif
+
+/* Emscripten embeds the pack in its in-memory file system, so it is read once instead of
+   mapped; views into it are still zero-copy. */
+typedef struct
+{
+    const unsigned char*       base;
+    size_t                     size;
+    const rasset_rpak_entry_t* entries;
+    uint32_t                   entry_count;
+    uint32_t*                  index; /* open-addressed, entry index + 1, 0 marks an empty bucket */
+    uint32_t                   index_capacity;
+#if defined(_WIN32)
+    HANDLE file;
+    HANDLE mapping;
+#elif !defined(RASSET_MMAP)
+    unsigned char* buffer;
+#endif
+} rasset_pack_t;
+
+static rasset_pack_t g_asset_pack;
+
+static const char* rasset_normalize_path(const char* path)
+{
+    while (path[0] == '.' && path[1] == '/')
+    {
+        path += 2;
+    }
+    return path;
+}
+
+static bool rasset_map_file(const char* pack_path)
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(pack_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    HANDLE        mapping = NULL;
+    const void*   base    = NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        base    = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    }
+    if (!base)
+    {
+        if (mapping)
+        {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+
+    g_asset_pack.file    = file;
+    g_asset_pack.mapping = mapping;
+    g_asset_pack.base    = (const unsigned char*)base;
+    g_asset_pack.size    = (size_t)size.QuadPart;
+    return true;
+#elif defined(RASSET_MMAP)
+    int fd = open(pack_path, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    void*       base = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+        base = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // The mapping keeps the file alive on its own
+    close(fd);
+
+    if (base == MAP_FAILED)
+    {
+        return false;
+    }
+
+    g_asset_pack.base = (const unsigned char*)base;
+    g_asset_pack.size = (size_t)info.st_size;
+    return true;
+#else
+    rasset_view_t view;
+    if (!rasset_open(pack_path, &view))
+    {
+        return false;
+    }
+
+    g_asset_pack.buffer = (unsigned char*)view.owned;
+    g_asset_pack.base   = view.data;
+    g_asset_pack.size   = view.size;
+    return true;
+#endif
+}
+
+static void rasset_unmap_file(void)
+{
+    if (!g_asset_pack.base)
+    {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(g_asset_pack.base);
+    CloseHandle(g_asset_pack.mapping);
+    CloseHandle(g_asset_pack.file);
+#elif defined(RASSET_MMAP)
+    munmap((void*)g_asset_pack.base, g_asset_pack.size);
+#else
+    free(g_asset_pack.buffer);
+#endif
+}
+
+static bool rasset_validate_pack(void)
+{
+    const size_t size = g_asset_pack.size;
+    if (size < sizeof(rasset_rpak_header_t))
+    {
+        return false;
+    }
+
+    const rasset_rpak_header_t* header = (const rasset_rpak_header_t*)g_asset_pack.base;
+    if (header->magic != RASSET_RPAK_MAGIC || header->version != RASSET_RPAK_VERSION)
+    {
+        return false;
+    }
+
+    // Bound every count by the bytes left before doing arithmetic with it, so a corrupt header
+    // cannot wrap size_t on 32-bit targets; the index also needs 2x entry_count buckets in a uint32_t
+    const size_t max_entries = (size - sizeof(*header)) / sizeof(rasset_rpak_entry_t);
+    if (header->entry_count > max_entries || header->entry_count > UINT32_MAX / 4u)
+    {
+        return false;
+    }
+
+    size_t names_begin = sizeof(*header) + (size_t)header->entry_count * sizeof(rasset_rpak_entry_t);
+    if (header->names_size == 0 || header->names_size > size - names_begin)
+    {
+        return false;
+    }
+
+    size_t names_end = names_begin + header->names_size;
+    if (g_asset_pack.base[names_end - 1] != '\0')
+    {
+        return false;
+    }
+
+    const rasset_rpak_entry_t* entries = (const rasset_rpak_entry_t*)(g_asset_pack.base + sizeof(*header));
+    for (uint32_t i = 0; i < header->entry_count; ++i)
+    {
+        if (entries[i].name_offset < names_begin || entries[i].name_offset >= names_end ||
+            entries[i].data_offset >= size || entries[i].data_size >= size - entries[i].data_offset ||
+            g_asset_pack.base[(size_t)entries[i].data_offset + entries[i].data_size] != 0)
+        {
+            return false;
+        }
+    }
+
+    g_asset_pack.entries     = entries;
+    g_asset_pack.entry_count = header->entry_count;
+    return true;
+}
+
+static bool rasset_build_index(void)
+{
+    uint32_t capacity = 16u;
+    while (capacity < g_asset_pack.entry_count * 2u)
+    {
+        capacity *= 2u;
+    }
+
+    g_asset_pack.index = (uint32_t*)calloc(capacity, sizeof(uint32_t));
+    if (!g_asset_pack.index)
+    {
+        return false;
+    }
+    g_asset_pack.index_capacity = capacity;
+
+    for (uint32_t i = 0; i < g_asset_pack.entry_count; ++i)
+    {
+        uint32_t bucket = g_asset_pack.entries[i].name_hash & (capacity - 1u);
+        while (g_asset_pack.index[bucket])
+        {
+            bucket = (bucket + 1u) & (capacity - 1u);
+        }
+        g_asset_pack.index[bucket] = i + 1u;
+    }
+    return true;
+}
+
+bool rasset_mount(const char* pack_path)
+{
+    if (!pack_path)
+    {
+        return false;
+    }
+
+    rasset_unmount();
+
+    if (!rasset_map_file(pack_path))
+    {
+        rlog_info("rasset: no asset pack at %s, reading loose files", pack_path);
+        return false;
+    }
+
+    if (!rasset_validate_pack() || !rasset_build_index())
+    {
+        rlog_error("rasset: %s is not a valid asset pack", pack_path);
+        rasset_unmount();
+        return false;
+    }
+
+    rlog_info("rasset: mounted %s (%u files, %zu bytes)", pack_path, g_asset_pack.entry_count, g_asset_pack.size);
+    return true;
+}
+
+void rasset_unmount(void)
+{
+    rasset_unmap_file();
+    free(g_asset_pack.index);
+    memset(&g_asset_pack, 0, sizeof(g_asset_pack));
+}
+
+bool rasset_is_mounted(void)
+{
+    return g_asset_pack.index != NULL;
+}
+
+bool rasset_find(const char* path, rasset_view_t* out_view)
+{
+    if (!path || !out_view || !g_asset_pack.index)
+    {
+        return false;
+    }
+
+    path = rasset_normalize_path(path);
+
+    const uint32_t mask   = g_asset_pack.index_capacity - 1u;
+    const uint32_t hash   = rasset_rpak_hash(path);
+    uint32_t       bucket = hash & mask;
+    while (g_asset_pack.index[bucket])
+    {
+        const rasset_rpak_entry_t* entry = &g_asset_pack.entries[g_asset_pack.index[bucket] - 1u];
+        if (entry->name_hash == hash && strcmp((const char*)g_asset_pack.base + entry->name_offset, path) == 0)
+        {
+            out_view->data  = g_asset_pack.base + entry->data_offset;
+            out_view->size  = entry->data_size;
+            out_view->owned = NULL;
+            return true;
+        }
+        bucket = (bucket + 1u) & mask;
+    }
+    return false;
+}
+
+bool rasset_open(const char* path, rasset_view_t* out_view)
+{
+    if (!path || !out_view)
+    {
+        return false;
+    }
+
+    if (rasset_find(path, out_view))
+    {
+        return true;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file)
+    {
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    unsigned char* buffer = size >= 0 ? (unsigned char*)malloc((size_t)size + 1u) : NULL;
+    if (buffer && fread(buffer, 1, (size_t)size, file) != (size_t)size)
+    {
+        free(buffer);
+        buffer = NULL;
+    }
+    fclose(file);
+
+    if (!buffer)
+    {
+        rlog_error("rasset: failed to read %s", path);
+        return false;
+    }
+
+    buffer[size]    = 0;
+    out_view->data  = buffer;
+    out_view->size  = (size_t)size;
+    out_view->owned = buffer;
+    return true;
+}
+
+void rasset_close(rasset_view_t* view)
+{
+    if (!view)
+    {
+        return;
+    }
+
+    free(view->owned);
+    view->data  = NULL;
+    view->size  = 0;
+    view->owned = NULL;
+}
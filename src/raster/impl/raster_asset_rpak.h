@@ -0,0 +1,42 @@
+#pragma once
+
+/*
+    .rpak - asset pack written by tools/asset_pack and mapped by rasset_mount
+
+    Little-endian header, then entry_count entries, then the NUL-terminated entry names, then
+    the file contents. Every file starts on an RASSET_RPAK_DATA_ALIGNMENT boundary and is
+    followed by a zero byte that data_size does not count, so text can be read in place.
+*/
+
+#include <stdint.h>
+
+#define RASSET_RPAK_MAGIC          0x4B415052u /* "RPAK" */
+#define RASSET_RPAK_VERSION        1u
+#define RASSET_RPAK_DATA_ALIGNMENT 16u
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t names_size; /* bytes of the name table that follows the entries */
+} rasset_rpak_header_t;
+
+typedef struct
+{
+    uint32_t name_hash;   /* FNV-1a of the name */
+    uint32_t name_offset; /* from the start of the file */
+    uint32_t data_offset; /* from the start of the file */
+    uint32_t data_size;
+} rasset_rpak_entry_t;
+
+static inline uint32_t rasset_rpak_hash(const char* name)
+{
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)name; *p; ++p)
+    {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
@@ -0,0 +1,466 @@
+#include "raster_gfx_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define RGFX_MAX_ATLASES             64u
+#define RGFX_ATLAS_DEFAULT_PAGE_SIZE 2048
+#define RGFX_ATLAS_DEFAULT_PADDING   2
+
+typedef struct
+{
+    rgfx_atlas_t* object;
+    uint32_t      generation;
+} rgfx_atlas_slot_t;
+
+typedef struct
+{
+    uint32_t       source; /* index into desc->paths */
+    unsigned char* pixels;
+    int            width;
+    int            height;
+    bool           has_alpha;
+} rgfx_atlas_image_t;
+
+static rgfx_atlas_slot_t g_atlas_slots[RGFX_MAX_ATLASES];
+static uint32_t          g_atlas_free_stack[RGFX_MAX_ATLASES];
+static uint32_t          g_atlas_free_top          = 0;
+static bool              g_atlas_pool_initialized = false;
+
+static void rgfx_initialize_atlas_pool(void)
+{
+    if (g_atlas_pool_initialized)
+    {
+        return;
+    }
+
+    g_atlas_free_top = 0;
+    for (uint32_t i = 0; i < RGFX_MAX_ATLASES; ++i)
+    {
+        g_atlas_slots[i].object     = NULL;
+        g_atlas_slots[i].generation = 1u;
+        g_atlas_free_stack[g_atlas_free_top++] = (RGFX_MAX_ATLASES - 1u) - i;
+    }
+
+    g_atlas_pool_initialized = true;
+}
+
+static rgfx_atlas_slot_t* rgfx_atlas_slot(rgfx_atlas_handle handle, uint32_t* out_index)
+{
+    if (handle == RGFX_INVALID_ATLAS_HANDLE || !g_atlas_pool_initialized)
+    {
+        return NULL;
+    }
+
+    uint32_t index = rgfx_handle_index(handle);
+    if (index >= RGFX_MAX_ATLASES)
+    {
+        return NULL;
+    }
+
+    rgfx_atlas_slot_t* slot = &g_atlas_slots[index];
+    if (slot->object == NULL || slot->generation != rgfx_handle_generation(handle))
+    {
+        return NULL;
+    }
+
+    if (out_index)
+    {
+        *out_index = index;
+    }
+
+    return slot;
+}
+
+static uint32_t rgfx_atlas_hash_name(const char* name)
+{
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)name; *p; ++p)
+    {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* Region names live in an open-addressed index sized once at build time; buckets hold region index + 1 */
+static bool rgfx_atlas_build_index(rgfx_atlas_t* atlas)
+{
+    uint32_t buckets = 16u;
+    while (buckets < atlas->region_count * 2u)
+    {
+        buckets *= 2u;
+    }
+
+    atlas->region_index = (uint32_t*)calloc(buckets, sizeof(uint32_t));
+    if (!atlas->region_index)
+    {
+        return false;
+    }
+    atlas->region_index_mask = buckets - 1u;
+
+    for (uint32_t i = 0; i < atlas->region_count; ++i)
+    {
+        uint32_t bucket = atlas->regions[i].name_hash & atlas->region_index_mask;
+        while (atlas->region_index[bucket])
+        {
+            bucket = (bucket + 1u) & atlas->region_index_mask;
+        }
+        atlas->region_index[bucket] = i + 1u;
+    }
+    return true;
+}
+
+static void rgfx_atlas_free(rgfx_atlas_t* atlas)
+{
+    if (!atlas)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < atlas->page_count; ++i)
+    {
+        rgfx_internal_state_forget_texture(atlas->pages[i]);
+        glDeleteTextures(1, &atlas->pages[i]);
+    }
+    for (uint32_t i = 0; i < atlas->region_count; ++i)
+    {
+        free(atlas->regions[i].name);
+    }
+
+    free(atlas->pages);
+    free(atlas->regions);
+    free(atlas->region_index);
+    free(atlas);
+}
+
+static int rgfx_atlas_image_compare(const void* lhs, const void* rhs)
+{
+    const rgfx_atlas_image_t* a = (const rgfx_atlas_image_t*)lhs;
+    const rgfx_atlas_image_t* b = (const rgfx_atlas_image_t*)rhs;
+
+    // Tallest first packs a skyline tightest; ties keep the caller's order so builds are stable
+    if (a->height != b->height)
+    {
+        return a->height > b->height ? -1 : 1;
+    }
+    if (a->width != b->width)
+    {
+        return a->width > b->width ? -1 : 1;
+    }
+    return a->source < b->source ? -1 : (a->source > b->source ? 1 : 0);
+}
+
+/* Copies the image into the page and repeats its border pixels into the padding so linear
+   filtering at the region's edge never samples a neighbour */
+static void rgfx_atlas_blit(unsigned char* page, int page_size, const rgfx_atlas_image_t* image, int x, int y, int padding)
+{
+    const size_t page_stride = (size_t)page_size * 4u;
+    const size_t row_bytes   = (size_t)image->width * 4u;
+
+    for (int row = -padding; row < image->height + padding; ++row)
+    {
+        int            source_row = row < 0 ? 0 : (row >= image->height ? image->height - 1 : row);
+        const uint8_t* source     = image->pixels + (size_t)source_row * row_bytes;
+        uint8_t*       target     = page + (size_t)(y + row) * page_stride + (size_t)x * 4u;
+
+        memcpy(target, source, row_bytes);
+        for (int column = 1; column <= padding; ++column)
+        {
+            memcpy(target - (size_t)column * 4u, source, 4u);
+            memcpy(target + row_bytes + (size_t)(column - 1) * 4u, source + row_bytes - 4u, 4u);
+        }
+    }
+}
+
+static bool rgfx_atlas_upload_page(rgfx_atlas_t* atlas, const unsigned char* pixels)
+{
+    unsigned int* pages = (unsigned int*)realloc(atlas->pages, (size_t)(atlas->page_count + 1u) * sizeof(unsigned int));
+    if (!pages)
+    {
+        return false;
+    }
+    atlas->pages = pages;
+
+    unsigned int texture = 0;
+    glGenTextures(1, &texture);
+    if (!texture)
+    {
+        return false;
+    }
+
+    rgfx_internal_bind_texture(0, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, atlas->page_size, atlas->page_size, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    if (atlas->max_level > 0)
+    {
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    }
+    else
+    {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, atlas->max_level);
+
+    atlas->pages[atlas->page_count++] = texture;
+    return true;
+}
+
+static bool rgfx_atlas_pack_images(rgfx_atlas_t* atlas, rgfx_atlas_image_t* images, uint32_t image_count, int padding, const char* const* paths)
+{
+    const size_t   page_bytes = (size_t)atlas->page_size * (size_t)atlas->page_size * 4u;
+    unsigned char* page       = (unsigned char*)calloc(page_bytes, 1);
+    rgfx_skyline_t skyline    = { 0 };
+    bool           page_used  = false;
+    bool           ok         = page && rgfx_internal_skyline_init(&skyline, atlas->page_size);
+
+    for (uint32_t i = 0; ok && i < image_count; ++i)
+    {
+        const rgfx_atlas_image_t* image  = &images[i];
+        int                       width  = image->width + padding * 2;
+        int                       height = image->height + padding * 2;
+        if (width > atlas->page_size || height > atlas->page_size)
+        {
+            rlog_warning("rgfx: %s (%dx%d) does not fit a %dpx atlas page, skipping",
+                         paths[image->source],
+                         image->width,
+                         image->height,
+                         atlas->page_size);
+            continue;
+        }
+
+        int x = 0;
+        int y = 0;
+        if (!rgfx_internal_skyline_pack(&skyline, atlas->page_size, atlas->page_size, width, height, &x, &y))
+        {
+            // The page is full: upload it and start the next one
+            ok = rgfx_atlas_upload_page(atlas, page);
+            memset(page, 0, page_bytes);
+            rgfx_internal_skyline_free(&skyline);
+            ok = ok && rgfx_internal_skyline_init(&skyline, atlas->page_size) &&
+                 rgfx_internal_skyline_pack(&skyline, atlas->page_size, atlas->page_size, width, height, &x, &y);
+            if (!ok)
+            {
+                break;
+            }
+        }
+        page_used = true;
+
+        rgfx_atlas_blit(page, atlas->page_size, image, x + padding, y + padding, padding);
+
+        rgfx_atlas_region_t* region = &atlas->regions[atlas->region_count];
+        const char*          name   = paths[image->source];
+        region->name                = (char*)malloc(strlen(name) + 1);
+        if (!region->name)
+        {
+            ok = false;
+            break;
+        }
+        strcpy(region->name, name);
+
+        const float inverse_size = 1.0f / (float)atlas->page_size;
+        region->name_hash        = rgfx_atlas_hash_name(name);
+        region->page             = atlas->page_count;
+        region->has_alpha        = image->has_alpha;
+        region->width            = image->width;
+        region->height           = image->height;
+        region->uv_rect[0]       = (float)(x + padding) * inverse_size;
+        region->uv_rect[1]       = (float)(y + padding) * inverse_size;
+        region->uv_rect[2]       = (float)image->width * inverse_size;
+        region->uv_rect[3]       = (float)image->height * inverse_size;
+        atlas->region_count++;
+
+        atlas->pixels_used += (size_t)image->width * (size_t)image->height;
+    }
+
+    if (ok && page_used)
+    {
+        ok = rgfx_atlas_upload_page(atlas, page);
+    }
+
+    rgfx_internal_skyline_free(&skyline);
+    free(page);
+    return ok;
+}
+
+rgfx_atlas_handle rgfx_atlas_create(const rgfx_atlas_desc_t* desc)
+{
+    if (!desc || !desc->paths || desc->path_count == 0)
+    {
+        return RGFX_INVALID_ATLAS_HANDLE;
+    }
+
+    rgfx_initialize_atlas_pool();
+    if (g_atlas_free_top == 0)
+    {
+        rlog_error("rgfx: atlas pool exhausted (max %u)", (unsigned)RGFX_MAX_ATLASES);
+        return RGFX_INVALID_ATLAS_HANDLE;
+    }
+
+    GLint max_texture_size = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+
+    rgfx_atlas_t*       atlas  = (rgfx_atlas_t*)calloc(1, sizeof(rgfx_atlas_t));
+    rgfx_atlas_image_t* images = (rgfx_atlas_image_t*)calloc(desc->path_count, sizeof(rgfx_atlas_image_t));
+    if (!atlas || !images)
+    {
+        free(atlas);
+        free(images);
+        return RGFX_INVALID_ATLAS_HANDLE;
+    }
+
+    atlas->page_size = desc->page_size > 0 ? desc->page_size : RGFX_ATLAS_DEFAULT_PAGE_SIZE;
+    if (max_texture_size > 0 && atlas->page_size > max_texture_size)
+    {
+        atlas->page_size = max_texture_size;
+    }
+    int padding = desc->padding > 0 ? desc->padding : RGFX_ATLAS_DEFAULT_PADDING;
+
+    // Each mip halves the padding; stop at the last level that keeps a full texel of it, so
+    // minified sprites never average in their neighbours
+    for (int border = padding; border >= 2; border /= 2)
+    {
+        atlas->max_level++;
+    }
+
+    uint32_t image_count = 0;
+    for (uint32_t i = 0; i < desc->path_count; ++i)
+    {
+        rgfx_atlas_image_t* image    = &images[image_count];
+        int                 channels = 0;
+        // Flipped like rgfx_texture_acquire'd images so sprites sample them the same way
+        image->pixels = rgfx_internal_load_image(desc->paths[i], &image->width, &image->height, &channels, 4);
+        if (!image->pixels)
+        {
+            rlog_warning("rgfx: failed to load atlas image %s", desc->paths[i]);
+            continue;
+        }
+        image->source    = i;
+        image->has_alpha = channels == 4 || channels == 2;
+        image_count++;
+    }
+
+    qsort(images, image_count, sizeof(rgfx_atlas_image_t), rgfx_atlas_image_compare);
+
+    atlas->regions = (rgfx_atlas_region_t*)calloc(image_count ? image_count : 1u, sizeof(rgfx_atlas_region_t));
+    bool ok = atlas->regions && rgfx_atlas_pack_images(atlas, images, image_count, padding, desc->paths) &&
+              rgfx_atlas_build_index(atlas);
+
+    for (uint32_t i = 0; i < image_count; ++i)
+    {
+        rgfx_internal_free_image(images[i].pixels);
+    }
+    free(images);
+
+    if (!ok || atlas->region_count == 0)
+    {
+        rlog_error("rgfx: failed to build sprite atlas");
+        rgfx_atlas_free(atlas);
+        return RGFX_INVALID_ATLAS_HANDLE;
+    }
+
+    atlas->refcount = 1;
+
+    uint32_t index = g_atlas_free_stack[--g_atlas_free_top];
+    g_atlas_slots[index].object = atlas;
+    return rgfx_make_handle(index, g_atlas_slots[index].generation);
+}
+
+void rgfx_atlas_release(rgfx_atlas_handle atlas)
+{
+    uint32_t           index = 0;
+    rgfx_atlas_slot_t* slot  = rgfx_atlas_slot(atlas, &index);
+    if (!slot)
+    {
+        return;
+    }
+
+    if (--slot->object->refcount > 0)
+    {
+        return;
+    }
+
+    rgfx_atlas_free(slot->object);
+    slot->object     = NULL;
+    slot->generation = rgfx_next_generation(slot->generation);
+    g_atlas_free_stack[g_atlas_free_top++] = index;
+}
+
+void rgfx_atlas_get_stats(rgfx_atlas_handle atlas, rgfx_atlas_stats_t* out_stats)
+{
+    if (!out_stats)
+    {
+        return;
+    }
+
+    memset(out_stats, 0, sizeof(*out_stats));
+
+    rgfx_atlas_slot_t* slot = rgfx_atlas_slot(atlas, NULL);
+    if (!slot)
+    {
+        return;
+    }
+
+    const rgfx_atlas_t* object = slot->object;
+    out_stats->page_count      = object->page_count;
+    out_stats->page_size       = (uint32_t)object->page_size;
+    out_stats->region_count    = object->region_count;
+    out_stats->pixels_used     = object->pixels_used;
+    out_stats->pixels_total    = (size_t)object->page_count * (size_t)object->page_size * (size_t)object->page_size;
+    out_stats->efficiency      = out_stats->pixels_total ? (float)((double)out_stats->pixels_used / (double)out_stats->pixels_total) : 0.0f;
+}
+
+void rgfx_internal_atlas_retain(rgfx_atlas_handle atlas)
+{
+    rgfx_atlas_slot_t* slot = rgfx_atlas_slot(atlas, NULL);
+    if (slot)
+    {
+        slot->object->refcount++;
+    }
+}
+
+const rgfx_atlas_region_t* rgfx_internal_atlas_find_region(rgfx_atlas_handle atlas, const char* name, unsigned int* out_texture)
+{
+    rgfx_atlas_slot_t* slot = rgfx_atlas_slot(atlas, NULL);
+    if (!slot || !name)
+    {
+        return NULL;
+    }
+
+    const rgfx_atlas_t* object = slot->object;
+    uint32_t            hash   = rgfx_atlas_hash_name(name);
+    uint32_t            bucket = hash & object->region_index_mask;
+    while (object->region_index[bucket])
+    {
+        const rgfx_atlas_region_t* region = &object->regions[object->region_index[bucket] - 1u];
+        if (region->name_hash == hash && strcmp(region->name, name) == 0)
+        {
+            if (out_texture)
+            {
+                *out_texture = object->pages[region->page];
+            }
+            return region;
+        }
+        bucket = (bucket + 1u) & object->region_index_mask;
+    }
+    return NULL;
+}
+
+void rgfx_internal_atlas_shutdown(void)
+{
+    if (!g_atlas_pool_initialized)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < RGFX_MAX_ATLASES; ++i)
+    {
+        rgfx_atlas_free(g_atlas_slots[i].object);
+        g_atlas_slots[i].object = NULL;
+    }
+
+    g_atlas_pool_initialized = false;
+}
@@ -0,0 +1,367 @@
+#include "raster_gfx_internal.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RGFX_BATCH_INITIAL_CAPACITY 256u
+
+typedef struct
+{
+    float model[16];
+    float color[3];
+    float size[2];
+    float uv_rect[4];
+} rgfx_sprite_instance_t;
+
+typedef struct
+{
+    unsigned int               program;
+    const rgfx_program_info_t* program_info;
+    unsigned int               texture;
+    rgfx_sprite_handle         uniform_source;
+    uint32_t                   sequence;
+    bool                       translucent;
+} rgfx_batch_item_t;
+
+static struct
+{
+    unsigned int VAO;
+    unsigned int instanceVBO;
+    uint32_t     instance_buffer_capacity;
+
+    rgfx_batch_item_t*      items;
+    rgfx_sprite_instance_t* instances;
+    rgfx_sprite_instance_t* upload;
+    uint32_t                count;
+    uint32_t                capacity;
+
+    bool active;
+} g_batch = { 0 };
+
+static void rgfx_batch_bind_instance_attributes(uint32_t first_instance)
+{
+    const GLsizei stride = (GLsizei)sizeof(rgfx_sprite_instance_t);
+    const size_t  base   = (size_t)first_instance * sizeof(rgfx_sprite_instance_t);
+
+    for (int column = 0; column < 4; ++column)
+    {
+        size_t offset = base + offsetof(rgfx_sprite_instance_t, model) + (size_t)column * 4 * sizeof(float);
+        glVertexAttribPointer(RGFX_ATTRIB_INSTANCE_MODEL + column, 4, GL_FLOAT, GL_FALSE, stride, (void*)offset);
+    }
+
+    glVertexAttribPointer(RGFX_ATTRIB_INSTANCE_COLOR,
+                          3,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          stride,
+                          (void*)(base + offsetof(rgfx_sprite_instance_t, color)));
+    glVertexAttribPointer(RGFX_ATTRIB_INSTANCE_SIZE,
+                          2,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          stride,
+                          (void*)(base + offsetof(rgfx_sprite_instance_t, size)));
+    glVertexAttribPointer(RGFX_ATTRIB_INSTANCE_UV,
+                          4,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          stride,
+                          (void*)(base + offsetof(rgfx_sprite_instance_t, uv_rect)));
+}
+
+static bool rgfx_batch_ensure_gl_objects(void)
+{
+    if (g_batch.VAO)
+    {
+        return true;
+    }
+
+    glGenVertexArrays(1, &g_batch.VAO);
+    glGenBuffers(1, &g_batch.instanceVBO);
+
+    if (!g_batch.VAO || !g_batch.instanceVBO)
+    {
+        rlog_error("rgfx: failed to create sprite batch buffers");
+        rgfx_internal_batch_shutdown();
+        return false;
+    }
+
+    // Per-vertex data comes from the shared quad; this VAO only adds the per-instance stream
+    rgfx_internal_bind_vertex_array(g_batch.VAO);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, rgfx_internal_quad_geometry()->EBO);
+    rgfx_internal_quad_bind_vertex_attributes();
+
+    // Never leave the instance buffer empty: a non-instanced draw through this VAO still sources instance 0
+    g_batch.instance_buffer_capacity = RGFX_BATCH_INITIAL_CAPACITY;
+    glBindBuffer(GL_ARRAY_BUFFER, g_batch.instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER,
+                 (GLsizeiptr)(g_batch.instance_buffer_capacity * sizeof(rgfx_sprite_instance_t)),
+                 NULL,
+                 GL_STREAM_DRAW);
+
+    rgfx_batch_bind_instance_attributes(0);
+    for (int location = RGFX_ATTRIB_INSTANCE_MODEL; location <= RGFX_ATTRIB_INSTANCE_SIZE; ++location)
+    {
+        glEnableVertexAttribArray((GLuint)location);
+        glVertexAttribDivisor((GLuint)location, 1);
+    }
+    glEnableVertexAttribArray(RGFX_ATTRIB_INSTANCE_UV);
+    glVertexAttribDivisor(RGFX_ATTRIB_INSTANCE_UV, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    rgfx_internal_bind_vertex_array(0);
+
+    return true;
+}
+
+static bool rgfx_batch_reserve(uint32_t count)
+{
+    if (count <= g_batch.capacity)
+    {
+        return true;
+    }
+
+    uint32_t new_capacity = g_batch.capacity ? g_batch.capacity : RGFX_BATCH_INITIAL_CAPACITY;
+    while (new_capacity < count)
+    {
+        new_capacity *= 2u;
+    }
+
+    rgfx_batch_item_t* items =
+        (rgfx_batch_item_t*)realloc(g_batch.items, (size_t)new_capacity * sizeof(rgfx_batch_item_t));
+    if (!items)
+    {
+        return false;
+    }
+    g_batch.items = items;
+
+    rgfx_sprite_instance_t* instances =
+        (rgfx_sprite_instance_t*)realloc(g_batch.instances, (size_t)new_capacity * sizeof(rgfx_sprite_instance_t));
+    if (!instances)
+    {
+        return false;
+    }
+    g_batch.instances = instances;
+
+    rgfx_sprite_instance_t* upload =
+        (rgfx_sprite_instance_t*)realloc(g_batch.upload, (size_t)new_capacity * sizeof(rgfx_sprite_instance_t));
+    if (!upload)
+    {
+        return false;
+    }
+    g_batch.upload = upload;
+
+    g_batch.capacity = new_capacity;
+    return true;
+}
+
+static int rgfx_batch_item_compare(const void* lhs, const void* rhs)
+{
+    const rgfx_batch_item_t* a = (const rgfx_batch_item_t*)lhs;
+    const rgfx_batch_item_t* b = (const rgfx_batch_item_t*)rhs;
+
+    // Opaque sprites are grouped by state; blended ones follow in submission order, since
+    // reordering them would change what shows through what
+    if (a->translucent != b->translucent)
+    {
+        return a->translucent ? 1 : -1;
+    }
+    if (a->translucent && a->sequence != b->sequence)
+    {
+        return a->sequence < b->sequence ? -1 : 1;
+    }
+    if (a->program != b->program)
+    {
+        return a->program < b->program ? -1 : 1;
+    }
+    if (a->texture != b->texture)
+    {
+        return a->texture < b->texture ? -1 : 1;
+    }
+    if (a->uniform_source != b->uniform_source)
+    {
+        return a->uniform_source < b->uniform_source ? -1 : 1;
+    }
+    if (a->sequence != b->sequence)
+    {
+        return a->sequence < b->sequence ? -1 : 1;
+    }
+    return 0;
+}
+
+static bool rgfx_batch_items_mergeable(const rgfx_batch_item_t* a, const rgfx_batch_item_t* b)
+{
+    return a->program == b->program && a->texture == b->texture && a->uniform_source == RGFX_INVALID_SPRITE_HANDLE &&
+           b->uniform_source == RGFX_INVALID_SPRITE_HANDLE;
+}
+
+static void rgfx_batch_draw_run(const rgfx_batch_item_t* item,
+                                uint32_t                 first_instance,
+                                uint32_t                 instance_count)
+{
+    const rgfx_program_info_t* program = item->program_info;
+
+    rgfx_internal_use_program(item->program);
+
+    rgfx_internal_program_upload_frame(program);
+    glUniform1i(program->slots[RGFX_UNIFORM_SLOT_USE_TEXTURE], item->texture ? 1 : 0);
+
+    if (item->texture)
+    {
+        rgfx_internal_bind_texture(0, item->texture);
+        glUniform1i(program->slots[RGFX_UNIFORM_SLOT_TEXTURE], 0);
+    }
+
+    const rgfx_sprite_t* uniform_sprite = item->uniform_source != RGFX_INVALID_SPRITE_HANDLE
+                                              ? rgfx_internal_sprite_resolve(item->uniform_source)
+                                              : NULL;
+    rgfx_internal_sprite_apply_uniforms(program, uniform_sprite);
+
+    glBindBuffer(GL_ARRAY_BUFFER, g_batch.instanceVBO);
+    rgfx_batch_bind_instance_attributes(first_instance);
+
+    glDrawElementsInstanced(GL_TRIANGLES, RGFX_QUAD_INDEX_COUNT, GL_UNSIGNED_INT, 0, (GLsizei)instance_count);
+    rgfx_internal_stats_count_draw(true);
+}
+
+static void rgfx_batch_flush(void)
+{
+    uint32_t count = g_batch.count;
+    if (count == 0)
+    {
+        return;
+    }
+
+    g_batch.count = 0;
+
+    if (!rgfx_batch_ensure_gl_objects())
+    {
+        return;
+    }
+
+    qsort(g_batch.items, count, sizeof(rgfx_batch_item_t), rgfx_batch_item_compare);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        g_batch.upload[i] = g_batch.instances[g_batch.items[i].sequence];
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, g_batch.instanceVBO);
+    if (count > g_batch.instance_buffer_capacity)
+    {
+        while (g_batch.instance_buffer_capacity < count)
+        {
+            g_batch.instance_buffer_capacity *= 2u;
+        }
+    }
+    // Orphan the previous storage so the driver does not stall on in-flight draws
+    glBufferData(GL_ARRAY_BUFFER,
+                 (GLsizeiptr)(g_batch.instance_buffer_capacity * sizeof(rgfx_sprite_instance_t)),
+                 NULL,
+                 GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)(count * sizeof(rgfx_sprite_instance_t)), g_batch.upload);
+
+    rgfx_internal_bind_vertex_array(g_batch.VAO);
+
+    uint32_t run_start = 0;
+    while (run_start < count)
+    {
+        uint32_t run_end = run_start + 1;
+        while (run_end < count && rgfx_batch_items_mergeable(&g_batch.items[run_start], &g_batch.items[run_end]))
+        {
+            run_end++;
+        }
+
+        rgfx_batch_draw_run(&g_batch.items[run_start], run_start, run_end - run_start);
+        run_start = run_end;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    rgfx_internal_stats_count_sprites(count);
+}
+
+void rgfx_internal_batch_push_sprite(const rgfx_sprite_t* sprite)
+{
+    if (!sprite || !sprite->transform)
+    {
+        return;
+    }
+
+    if (!rgfx_batch_reserve(g_batch.count + 1u))
+    {
+        rlog_error("rgfx: failed to grow sprite batch");
+        return;
+    }
+
+    // Texts queued before this sprite must reach the screen first
+    rgfx_internal_text_batch_flush();
+
+    uint32_t                index    = g_batch.count++;
+    rgfx_batch_item_t*      item     = &g_batch.items[index];
+    rgfx_sprite_instance_t* instance = &g_batch.instances[index];
+
+    item->program        = sprite->shaderProgram;
+    item->program_info   = sprite->program_info;
+    item->texture        = sprite->hasTexture ? sprite->textureID : 0;
+    item->uniform_source = sprite->uniform_count > 0 ? sprite->handle : RGFX_INVALID_SPRITE_HANDLE;
+    item->sequence       = index;
+    item->translucent    = rgfx_internal_sprite_is_translucent(sprite);
+
+    rtransform_get_world_matrix(sprite->transform, (vec4*)instance->model);
+    instance->color[0] = sprite->color.r;
+    instance->color[1] = sprite->color.g;
+    instance->color[2] = sprite->color.b;
+    instance->size[0]  = sprite->size[0];
+    instance->size[1]  = sprite->size[1];
+    memcpy(instance->uv_rect, sprite->uv_rect, sizeof(instance->uv_rect));
+
+    if (!g_batch.active)
+    {
+        rgfx_batch_flush();
+    }
+}
+
+void rgfx_internal_batch_shutdown(void)
+{
+    if (g_batch.VAO)
+    {
+        rgfx_internal_state_forget_vertex_array(g_batch.VAO);
+        glDeleteVertexArrays(1, &g_batch.VAO);
+    }
+    if (g_batch.instanceVBO)
+    {
+        glDeleteBuffers(1, &g_batch.instanceVBO);
+    }
+
+    free(g_batch.items);
+    free(g_batch.instances);
+    free(g_batch.upload);
+
+    memset(&g_batch, 0, sizeof(g_batch));
+}
+
+void rgfx_internal_batch_flush(void)
+{
+    rgfx_batch_flush();
+}
+
+void rgfx_batch_begin(void)
+{
+    if (g_batch.active)
+    {
+        rgfx_batch_flush();
+    }
+    g_batch.active = true;
+
+    rgfx_internal_text_batch_begin();
+}
+
+void rgfx_batch_end(void)
+{
+    g_batch.active = false;
+    rgfx_batch_flush();
+
+    rgfx_internal_text_batch_end();
+}
@@ -4,13 +4,8 @@
 #include <stdio.h>
 #include <string.h>
 
-#define RGFX_MAX_SPRITES 512u
+#define RGFX_MAX_SPRITES 65535u
 #define RGFX_MAX_TEXTS   256u
-#define RGFX_HANDLE_INDEX_MASK 0xFFFFu
-#define RGFX_HANDLE_GENERATION_SHIFT 16u
-
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb/stb_image.h>
 
 typedef struct
 {
@@ -24,9 +19,12 @@ typedef struct
     uint32_t     generation;
 } rgfx_text_slot_t;
 
-static rgfx_camera_t* g_active_camera        = NULL;
-static unsigned int   g_text_shader_program  = 0;
-static int            g_text_shader_refcount = 0;
+static rgfx_camera_t* g_active_camera = NULL;
+
+static rgfx_camera_state_t  g_camera_state;
+static const rgfx_camera_t* g_camera_state_source          = NULL;
+static uint32_t             g_camera_state_source_revision = 0;
+static bool                 g_camera_state_valid           = false;
 
 static rgfx_sprite_slot_t g_sprite_slots[RGFX_MAX_SPRITES];
 static uint32_t           g_sprite_free_stack[RGFX_MAX_SPRITES];
@@ -38,6 +36,20 @@ static uint32_t         g_text_free_top = 0;
 
 static bool g_handle_pools_initialized = false;
 
+static rgfx_frame_stats_t g_frame_stats;
+static rgfx_frame_stats_t g_last_frame_stats;
+
+static rgfx_quad_geometry_t g_quad = { 0 };
+
+static struct
+{
+    unsigned int          UBO;
+    rgfx_frame_uniforms_t data;
+    uint32_t              index;
+    uint32_t              camera_revision;
+    bool                  dirty;
+} g_frame = { 0 };
+
 static void rgfx_initialize_handle_pools(void)
 {
     if (g_handle_pools_initialized)
@@ -62,30 +74,17 @@ static void rgfx_initialize_handle_pools(void)
     g_handle_pools_initialized = true;
 }
 
-static inline uint32_t rgfx_handle_index(uint32_t handle)
-{
-    return (handle & RGFX_HANDLE_INDEX_MASK) - 1u;
-}
-
-static inline uint32_t rgfx_handle_generation(uint32_t handle)
-{
-    return handle >> RGFX_HANDLE_GENERATION_SHIFT;
-}
-
-static inline uint32_t rgfx_make_handle(uint32_t index, uint32_t generation)
-{
-    return ((generation & RGFX_HANDLE_INDEX_MASK) << RGFX_HANDLE_GENERATION_SHIFT) | (index + 1u);
-}
-
-static inline uint32_t rgfx_next_generation(uint32_t generation)
-{
-    generation = (generation + 1u) & RGFX_HANDLE_INDEX_MASK;
-    if (generation == 0u)
-    {
-        generation = 1u;
-    }
-    return generation;
-}
+/* Shared by every program through RGFX_FRAME_UNIFORM_BINDING; highp keeps both stages' declarations identical on GLSL ES */
+#define RGFX_FRAME_UNIFORM_BLOCK_SOURCE \
+    "layout (std140) uniform RasterFrame\n" \
+    "{\n" \
+    "    highp mat4 uView;\n" \
+    "    highp mat4 uProjection;\n" \
+    "    highp mat4 uViewProjection;\n" \
+    "    highp float uTime;\n" \
+    "    highp float uDeltaTime;\n" \
+    "    highp vec2 uViewportSize;\n" \
+    "};\n"
 
 #if defined(__EMSCRIPTEN__)
 static const char* const RGFX_DEFAULT_SPRITE_VERTEX_SHADER =
@@ -93,15 +92,17 @@ static const char* const RGFX_DEFAULT_SPRITE_VERTEX_SHADER =
     "precision mediump float;\n"
     "layout (location = 0) in vec2 aPos;\n"
     "layout (location = 1) in vec2 aTexCoord;\n"
+    "layout (location = 2) in mat4 aInstanceModel;\n"
+    "layout (location = 6) in vec3 aInstanceColor;\n"
+    "layout (location = 9) in vec4 aInstanceUVRect;\n"
     "out vec2 TexCoord;\n"
-    "uniform mat4 uModel;\n"
-    "uniform mat4 uView;\n"
-    "uniform mat4 uProjection;\n"
-    "uniform float uTime;\n"
+    "out vec3 vColor;\n"
+    RGFX_FRAME_UNIFORM_BLOCK_SOURCE
     "void main()\n"
     "{\n"
-    "    gl_Position = uProjection * uView * uModel * vec4(aPos, 0.0, 1.0);\n"
-    "    TexCoord = aTexCoord;\n"
+    "    gl_Position = uViewProjection * aInstanceModel * vec4(aPos, 0.0, 1.0);\n"
+    "    TexCoord = aInstanceUVRect.xy + aTexCoord * aInstanceUVRect.zw;\n"
+    "    vColor = aInstanceColor;\n"
     "}\n";
 
 static const char* const RGFX_DEFAULT_SPRITE_FRAGMENT_SHADER =
@@ -109,10 +110,9 @@ static const char* const RGFX_DEFAULT_SPRITE_FRAGMENT_SHADER =
     "precision mediump float;\n"
     "out vec4 FragColor;\n"
     "in vec2 TexCoord;\n"
+    "in vec3 vColor;\n"
     "uniform sampler2D uTexture;\n"
-    "uniform vec3 uColor;\n"
     "uniform bool uUseTexture;\n"
-    "uniform float uTime;\n"
     "void main()\n"
     "{\n"
     "    vec4 finalColor;\n"
@@ -121,9 +121,9 @@ static const char* const RGFX_DEFAULT_SPRITE_FRAGMENT_SHADER =
     "        if (texColor.a < 0.01) {\n"
     "            discard;\n"
     "        }\n"
-    "        finalColor = vec4(texColor.rgb * uColor, texColor.a);\n"
+    "        finalColor = vec4(texColor.rgb * vColor, texColor.a);\n"
     "    } else {\n"
-    "        finalColor = vec4(uColor, 1.0);\n"
+    "        finalColor = vec4(vColor, 1.0);\n"
     "    }\n"
     "    FragColor = finalColor;\n"
     "}\n";
@@ -134,12 +134,11 @@ static const char* const RGFX_DEFAULT_TEXT_VERTEX_SHADER =
     "layout (location = 0) in vec2 aPos;\n"
     "layout (location = 1) in vec2 aTexCoord;\n"
     "uniform mat4 uModel;\n"
-    "uniform mat4 uView;\n"
-    "uniform mat4 uProjection;\n"
+    RGFX_FRAME_UNIFORM_BLOCK_SOURCE
     "out vec2 TexCoord;\n"
     "void main()\n"
     "{\n"
-    "    gl_Position = uProjection * uView * uModel * vec4(aPos, 0.0, 1.0);\n"
+    "    gl_Position = uViewProjection * uModel * vec4(aPos, 0.0, 1.0);\n"
     "    TexCoord = aTexCoord;\n"
     "}\n";
 
@@ -158,30 +157,99 @@ static const char* const RGFX_DEFAULT_TEXT_FRAGMENT_SHADER =
     "    }\n"
     "    FragColor = vec4(uColor, textAlpha);\n"
     "}\n";
+
+static const char* const RGFX_DEFAULT_TEXT_SDF_FRAGMENT_SHADER =
+    "#version 300 es\n"
+    "precision mediump float;\n"
+    "in vec2 TexCoord;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D uTexture;\n"
+    "uniform vec3 uColor;\n"
+    "void main()\n"
+    "{\n"
+    "    float dist = texture(uTexture, TexCoord).r;\n"
+    "    float width = max(fwidth(dist), 0.0001);\n"
+    "    float textAlpha = smoothstep(0.5 - width, 0.5 + width, dist);\n"
+    "    if (textAlpha < 0.01) {\n"
+    "        discard;\n"
+    "    }\n"
+    "    FragColor = vec4(uColor, textAlpha);\n"
+    "}\n";
+
+static const char* const RGFX_DEFAULT_TEXT_BATCH_VERTEX_SHADER =
+    "#version 300 es\n"
+    "precision mediump float;\n"
+    "layout (location = 0) in vec3 aPos;\n"
+    "layout (location = 1) in vec2 aTexCoord;\n"
+    "layout (location = 8) in vec3 aColor;\n"
+    RGFX_FRAME_UNIFORM_BLOCK_SOURCE
+    "out vec2 TexCoord;\n"
+    "out vec3 vColor;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = uViewProjection * vec4(aPos, 1.0);\n"
+    "    TexCoord = aTexCoord;\n"
+    "    vColor = aColor;\n"
+    "}\n";
+
+static const char* const RGFX_DEFAULT_TEXT_BATCH_FRAGMENT_SHADER =
+    "#version 300 es\n"
+    "precision mediump float;\n"
+    "in vec2 TexCoord;\n"
+    "in vec3 vColor;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D uTexture;\n"
+    "void main()\n"
+    "{\n"
+    "    float textAlpha = texture(uTexture, TexCoord).r;\n"
+    "    if (textAlpha < 0.01) {\n"
+    "        discard;\n"
+    "    }\n"
+    "    FragColor = vec4(vColor, textAlpha);\n"
+    "}\n";
+
+static const char* const RGFX_DEFAULT_TEXT_BATCH_SDF_FRAGMENT_SHADER =
+    "#version 300 es\n"
+    "precision mediump float;\n"
+    "in vec2 TexCoord;\n"
+    "in vec3 vColor;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D uTexture;\n"
+    "void main()\n"
+    "{\n"
+    "    float dist = texture(uTexture, TexCoord).r;\n"
+    "    float width = max(fwidth(dist), 0.0001);\n"
+    "    float textAlpha = smoothstep(0.5 - width, 0.5 + width, dist);\n"
+    "    if (textAlpha < 0.01) {\n"
+    "        discard;\n"
+    "    }\n"
+    "    FragColor = vec4(vColor, textAlpha);\n"
+    "}\n";
 #else
 static const char* const RGFX_DEFAULT_SPRITE_VERTEX_SHADER =
     "#version 330 core\n"
     "layout (location = 0) in vec2 aPos;\n"
     "layout (location = 1) in vec2 aTexCoord;\n"
+    "layout (location = 2) in mat4 aInstanceModel;\n"
+    "layout (location = 6) in vec3 aInstanceColor;\n"
+    "layout (location = 9) in vec4 aInstanceUVRect;\n"
     "out vec2 TexCoord;\n"
-    "uniform mat4 uModel;\n"
-    "uniform mat4 uView;\n"
-    "uniform mat4 uProjection;\n"
-    "uniform float uTime;\n"
+    "out vec3 vColor;\n"
+    RGFX_FRAME_UNIFORM_BLOCK_SOURCE
     "void main()\n"
     "{\n"
-    "    gl_Position = uProjection * uView * uModel * vec4(aPos, 0.0, 1.0);\n"
-    "    TexCoord = aTexCoord;\n"
+    "    gl_Position = uViewProjection * aInstanceModel * vec4(aPos, 0.0, 1.0);\n"
+    "    TexCoord = aInstanceUVRect.xy + aTexCoord * aInstanceUVRect.zw;\n"
+    "    vColor = aInstanceColor;\n"
     "}\n";
 
 static const char* const RGFX_DEFAULT_SPRITE_FRAGMENT_SHADER =
     "#version 330 core\n"
     "out vec4 FragColor;\n"
     "in vec2 TexCoord;\n"
+    "in vec3 vColor;\n"
     "uniform sampler2D uTexture;\n"
-    "uniform vec3 uColor;\n"
     "uniform bool uUseTexture;\n"
-    "uniform float uTime;\n"
     "void main()\n"
     "{\n"
     "    vec4 finalColor;\n"
@@ -190,9 +258,9 @@ static const char* const RGFX_DEFAULT_SPRITE_FRAGMENT_SHADER =
     "        if (texColor.a < 0.01) {\n"
     "            discard;\n"
     "        }\n"
-    "        finalColor = vec4(texColor.rgb * uColor, texColor.a);\n"
+    "        finalColor = vec4(texColor.rgb * vColor, texColor.a);\n"
     "    } else {\n"
-    "        finalColor = vec4(uColor, 1.0);\n"
+    "        finalColor = vec4(vColor, 1.0);\n"
     "    }\n"
     "    FragColor = finalColor;\n"
     "}\n";
@@ -202,12 +270,11 @@ static const char* const RGFX_DEFAULT_TEXT_VERTEX_SHADER =
     "layout (location = 0) in vec2 aPos;\n"
     "layout (location = 1) in vec2 aTexCoord;\n"
     "uniform mat4 uModel;\n"
-    "uniform mat4 uView;\n"
-    "uniform mat4 uProjection;\n"
+    RGFX_FRAME_UNIFORM_BLOCK_SOURCE
     "out vec2 TexCoord;\n"
     "void main()\n"
     "{\n"
-    "    gl_Position = uProjection * uView * uModel * vec4(aPos, 0.0, 1.0);\n"
+    "    gl_Position = uViewProjection * uModel * vec4(aPos, 0.0, 1.0);\n"
     "    TexCoord = aTexCoord;\n"
     "}\n";
 
@@ -225,6 +292,70 @@ static const char* const RGFX_DEFAULT_TEXT_FRAGMENT_SHADER =
     "    }\n"
     "    FragColor = vec4(uColor, textAlpha);\n"
     "}\n";
+
+static const char* const RGFX_DEFAULT_TEXT_SDF_FRAGMENT_SHADER =
+    "#version 330 core\n"
+    "in vec2 TexCoord;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D uTexture;\n"
+    "uniform vec3 uColor;\n"
+    "void main()\n"
+    "{\n"
+    "    float dist = texture(uTexture, TexCoord).r;\n"
+    "    float width = max(fwidth(dist), 0.0001);\n"
+    "    float textAlpha = smoothstep(0.5 - width, 0.5 + width, dist);\n"
+    "    if (textAlpha < 0.01) {\n"
+    "        discard;\n"
+    "    }\n"
+    "    FragColor = vec4(uColor, textAlpha);\n"
+    "}\n";
+
+static const char* const RGFX_DEFAULT_TEXT_BATCH_VERTEX_SHADER =
+    "#version 330 core\n"
+    "layout (location = 0) in vec3 aPos;\n"
+    "layout (location = 1) in vec2 aTexCoord;\n"
+    "layout (location = 8) in vec3 aColor;\n"
+    RGFX_FRAME_UNIFORM_BLOCK_SOURCE
+    "out vec2 TexCoord;\n"
+    "out vec3 vColor;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = uViewProjection * vec4(aPos, 1.0);\n"
+    "    TexCoord = aTexCoord;\n"
+    "    vColor = aColor;\n"
+    "}\n";
+
+static const char* const RGFX_DEFAULT_TEXT_BATCH_FRAGMENT_SHADER =
+    "#version 330 core\n"
+    "in vec2 TexCoord;\n"
+    "in vec3 vColor;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D uTexture;\n"
+    "void main()\n"
+    "{\n"
+    "    float textAlpha = texture(uTexture, TexCoord).r;\n"
+    "    if (textAlpha < 0.01) {\n"
+    "        discard;\n"
+    "    }\n"
+    "    FragColor = vec4(vColor, textAlpha);\n"
+    "}\n";
+
+static const char* const RGFX_DEFAULT_TEXT_BATCH_SDF_FRAGMENT_SHADER =
+    "#version 330 core\n"
+    "in vec2 TexCoord;\n"
+    "in vec3 vColor;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D uTexture;\n"
+    "void main()\n"
+    "{\n"
+    "    float dist = texture(uTexture, TexCoord).r;\n"
+    "    float width = max(fwidth(dist), 0.0001);\n"
+    "    float textAlpha = smoothstep(0.5 - width, 0.5 + width, dist);\n"
+    "    if (textAlpha < 0.01) {\n"
+    "        discard;\n"
+    "    }\n"
+    "    FragColor = vec4(vColor, textAlpha);\n"
+    "}\n";
 #endif
 
 const char* rgfx_internal_default_sprite_vertex_shader(void)
@@ -247,6 +378,21 @@ const char* rgfx_internal_default_text_fragment_shader(void)
     return RGFX_DEFAULT_TEXT_FRAGMENT_SHADER;
 }
 
+const char* rgfx_internal_default_text_sdf_fragment_shader(void)
+{
+    return RGFX_DEFAULT_TEXT_SDF_FRAGMENT_SHADER;
+}
+
+const char* rgfx_internal_default_text_batch_vertex_shader(void)
+{
+    return RGFX_DEFAULT_TEXT_BATCH_VERTEX_SHADER;
+}
+
+const char* rgfx_internal_default_text_batch_fragment_shader(bool sdf)
+{
+    return sdf ? RGFX_DEFAULT_TEXT_BATCH_SDF_FRAGMENT_SHADER : RGFX_DEFAULT_TEXT_BATCH_FRAGMENT_SHADER;
+}
+
 rgfx_sprite_handle rgfx_internal_sprite_register(rgfx_sprite_t* sprite)
 {
     if (!sprite)
@@ -405,154 +551,77 @@ void rgfx_internal_text_unregister(rgfx_text_handle handle)
     g_text_free_stack[g_text_free_top++] = index;
 }
 
-static unsigned int rgfx_compile_shader(unsigned int type, const char* source)
+static void rgfx_destroy_quad_geometry(void)
 {
-    unsigned int shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, NULL);
-    glCompileShader(shader);
-
-    int success = 0;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success)
+    if (g_quad.VAO)
     {
-        char infoLog[512];
-        glGetShaderInfoLog(shader, 512, NULL, infoLog);
-        rlog_error("ERROR: Shader compilation failed\n%s\n", infoLog);
-        glDeleteShader(shader);
-        return 0;
+        rgfx_internal_state_forget_vertex_array(g_quad.VAO);
+        glDeleteVertexArrays(1, &g_quad.VAO);
     }
-
-    return shader;
-}
-
-unsigned int rgfx_create_shader_program(const char* vertexSource, const char* fragmentSource)
-{
-    if (!vertexSource || !fragmentSource)
+    if (g_quad.VBO)
     {
-        return 0;
+        glDeleteBuffers(1, &g_quad.VBO);
     }
-
-    unsigned int vertexShader   = rgfx_compile_shader(GL_VERTEX_SHADER, vertexSource);
-    unsigned int fragmentShader = vertexShader ? rgfx_compile_shader(GL_FRAGMENT_SHADER, fragmentSource) : 0;
-
-    if (!vertexShader || !fragmentShader)
+    if (g_quad.EBO)
     {
-        if (vertexShader)
-        {
-            glDeleteShader(vertexShader);
-        }
-        if (fragmentShader)
-        {
-            glDeleteShader(fragmentShader);
-        }
-        return 0;
+        glDeleteBuffers(1, &g_quad.EBO);
     }
 
-    unsigned int shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
+    memset(&g_quad, 0, sizeof(g_quad));
+}
 
-    int success = 0;
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success)
-    {
-        char infoLog[512];
-        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-        rlog_error("Shader program linking failed\n%s\n", infoLog);
-        glDeleteProgram(shaderProgram);
-        shaderProgram = 0;
-    }
+static bool rgfx_create_quad_geometry(void)
+{
+    const float quad_vertices[] = {
+        -0.5f, -0.5f, 0.0f, 0.0f,
+         0.5f, -0.5f, 1.0f, 0.0f,
+         0.5f,  0.5f, 1.0f, 1.0f,
+        -0.5f,  0.5f, 0.0f, 1.0f,
+    };
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    const unsigned int quad_indices[RGFX_QUAD_INDEX_COUNT] = { 0, 1, 2, 2, 3, 0 };
 
-    return shaderProgram;
-}
+    glGenVertexArrays(1, &g_quad.VAO);
+    glGenBuffers(1, &g_quad.VBO);
+    glGenBuffers(1, &g_quad.EBO);
 
-char* rgfx_load_shader_source(const char* filepath)
-{
-    if (!filepath)
+    if (!g_quad.VAO || !g_quad.VBO || !g_quad.EBO)
     {
-        return NULL;
+        rlog_error("rgfx: failed to create shared quad geometry");
+        rgfx_destroy_quad_geometry();
+        return false;
     }
 
-    FILE* file = fopen(filepath, "rb");
-    if (!file)
-    {
-        rlog_error("Failed to open shader file: %s\n", filepath);
-        return NULL;
-    }
+    rgfx_internal_bind_vertex_array(g_quad.VAO);
 
-    fseek(file, 0, SEEK_END);
-    long size = ftell(file);
-    fseek(file, 0, SEEK_SET);
+    glBindBuffer(GL_ARRAY_BUFFER, g_quad.VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad_vertices), quad_vertices, GL_STATIC_DRAW);
 
-    char* source = (char*)malloc(size + 1);
-    if (!source)
-    {
-        fclose(file);
-        rlog_error("Failed to allocate memory for shader source\n");
-        return NULL;
-    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_quad.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(quad_indices), quad_indices, GL_STATIC_DRAW);
 
-    size_t bytesRead = fread(source, 1, size, file);
-    fclose(file);
+    rgfx_internal_quad_bind_vertex_attributes();
 
-    if (bytesRead < (size_t)size)
-    {
-        free(source);
-        rlog_error("Failed to read shader file: %s\n", filepath);
-        return NULL;
-    }
+    rgfx_internal_bind_vertex_array(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    source[size] = '\0';
+    return true;
+}
 
-    if (strstr(source, "#version") == NULL)
-    {
-        const char* version_directive = NULL;
-#if defined(__EMSCRIPTEN__)
-        rlog_info("Using WebGL/GLSL ES shader version for file: %s", filepath);
-        version_directive = "#version 300 es\nprecision mediump float;\n";
-#else
-        rlog_info("Using Desktop/GLSL shader version for file: %s", filepath);
-        version_directive = "#version 330 core\n";
-#endif
-        size_t directive_len = strlen(version_directive);
-        char*  new_source    = (char*)malloc(directive_len + size + 1);
-        if (!new_source)
-        {
-            free(source);
-            rlog_error("Failed to allocate memory for shader source with version directive\n");
-            return NULL;
-        }
+const rgfx_quad_geometry_t* rgfx_internal_quad_geometry(void)
+{
+    return &g_quad;
+}
 
-        strcpy(new_source, version_directive);
-        strcat(new_source, source);
-        free(source);
-        source = new_source;
-    }
-    else
-    {
-        char        versionLine[64] = { 0 };
-        const char* versionStart    = strstr(source, "#version");
-        if (versionStart)
-        {
-            const char* lineEnd = strchr(versionStart, '\n');
-            if (lineEnd)
-            {
-                size_t len = (size_t)(lineEnd - versionStart);
-                if (len < sizeof(versionLine) - 1)
-                {
-                    strncpy(versionLine, versionStart, len);
-                    versionLine[len] = '\0';
-                    rlog_info("Found existing version directive in %s: %s", filepath, versionLine);
-                }
-            }
-        }
-    }
+void rgfx_internal_quad_bind_vertex_attributes(void)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, g_quad.VBO);
 
-    return source;
+    glVertexAttribPointer(RGFX_ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(RGFX_ATTRIB_POSITION);
+
+    glVertexAttribPointer(RGFX_ATTRIB_TEXCOORD, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(RGFX_ATTRIB_TEXCOORD);
 }
 
 bool rgfx_init(void)
@@ -562,12 +631,33 @@ bool rgfx_init(void)
         return false;
     }
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    rgfx_internal_state_reset();
+
+    rgfx_internal_set_blend(true);
+    rgfx_internal_set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    glEnable(GL_DEPTH_TEST);
+    rgfx_internal_set_depth_test(true);
+    rgfx_internal_set_depth_write(true);
     glDepthFunc(GL_LEQUAL);
 
+    if (!rgfx_create_quad_geometry())
+    {
+        return false;
+    }
+
+    glGenBuffers(1, &g_frame.UBO);
+    if (!g_frame.UBO)
+    {
+        rlog_error("rgfx: failed to create frame uniform buffer");
+        rgfx_destroy_quad_geometry();
+        return false;
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, g_frame.UBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(rgfx_frame_uniforms_t), NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, RGFX_FRAME_UNIFORM_BINDING, g_frame.UBO);
+    g_frame.dirty = true;
+
     rgfx_initialize_handle_pools();
 
     return true;
@@ -575,118 +665,143 @@ bool rgfx_init(void)
 
 void rgfx_shutdown(void)
 {
-    if (g_text_shader_program)
+    rgfx_internal_queue_shutdown();
+    rgfx_internal_batch_shutdown();
+    rgfx_internal_text_batch_shutdown();
+
+    rgfx_internal_program_registry_shutdown();
+    rgfx_internal_texture_shutdown();
+    rgfx_internal_atlas_shutdown();
+    rgfx_internal_font_shutdown();
+    rgfx_destroy_quad_geometry();
+
+    if (g_frame.UBO)
     {
-        glDeleteProgram(g_text_shader_program);
-        g_text_shader_program  = 0;
-        g_text_shader_refcount = 0;
+        glDeleteBuffers(1, &g_frame.UBO);
     }
+    memset(&g_frame, 0, sizeof(g_frame));
 
-    g_active_camera = NULL;
+    g_active_camera      = NULL;
+    g_camera_state_valid = false;
 
     g_sprite_free_top         = 0;
     g_text_free_top           = 0;
     g_handle_pools_initialized = false;
 }
 
-void rgfx_clear(float r, float g, float b)
+void rgfx_begin_frame(void)
 {
-    glClearColor(r, g, b, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-}
+    memset(&g_frame_stats, 0, sizeof(g_frame_stats));
 
-void rgfx_clear_color(color color)
-{
-    glClearColor(color.r, color.g, color.b, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    GLint viewport[4] = { 0, 0, 0, 0 };
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    g_frame.index++;
+    g_frame.data.time             = rapp_get_time();
+    g_frame.data.delta_time       = rapp_get_delta_time();
+    g_frame.data.viewport_size[0] = (float)viewport[2];
+    g_frame.data.viewport_size[1] = (float)viewport[3];
+    g_frame.dirty                 = true;
+
+    // Settle the hierarchy once so draws read already-current world matrices
+    rtransform_update_all();
+
+    rgfx_internal_frame_uniforms_sync();
 }
 
-unsigned int rgfx_load_texture(const char* filepath)
+void rgfx_internal_frame_uniforms_sync(void)
 {
-    if (!filepath)
+    const rgfx_camera_state_t* camera = rgfx_internal_camera_state();
+    if (!g_frame.UBO || (!g_frame.dirty && g_frame.camera_revision == camera->revision))
     {
-        return 0;
+        return;
     }
 
-    unsigned int textureID = 0;
-    glGenTextures(1, &textureID);
+    memcpy(g_frame.data.view, camera->view, sizeof(g_frame.data.view));
+    memcpy(g_frame.data.projection, camera->projection, sizeof(g_frame.data.projection));
+    memcpy(g_frame.data.view_projection, camera->view_projection, sizeof(g_frame.data.view_projection));
 
-    int            width   = 0;
-    int            height  = 0;
-    int            channels = 0;
-    stbi_set_flip_vertically_on_load(1);
-    unsigned char* data = stbi_load(filepath, &width, &height, &channels, 0);
-    if (!data)
-    {
-        rlog_error("Failed to load texture: %s\n", filepath);
-        if (textureID)
-        {
-            glDeleteTextures(1, &textureID);
-        }
-        return 0;
-    }
+    glBindBuffer(GL_UNIFORM_BUFFER, g_frame.UBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(g_frame.data), &g_frame.data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
-    GLenum format = GL_RGB;
-    if (channels == 4)
-    {
-        format = GL_RGBA;
-    }
-    else if (channels == 1)
-    {
-        format = GL_RED;
-    }
+    g_frame.camera_revision = camera->revision;
+    g_frame.dirty           = false;
+}
+
+uint32_t rgfx_internal_frame_index(void)
+{
+    return g_frame.index;
+}
 
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
+float rgfx_internal_frame_time(void)
+{
+    return g_frame.data.time;
+}
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+void rgfx_end_frame(void)
+{
+    rgfx_internal_queue_flush();
 
-    stbi_image_free(data);
-    return textureID;
+    g_last_frame_stats = g_frame_stats;
 }
 
-void rgfx_delete_texture(unsigned int textureID)
+void rgfx_get_frame_stats(rgfx_frame_stats_t* out_stats)
 {
-    if (textureID)
+    if (out_stats)
     {
-        glDeleteTextures(1, &textureID);
+        *out_stats = g_last_frame_stats;
     }
 }
 
-unsigned int rgfx_internal_acquire_text_shader_program(void)
+void rgfx_internal_stats_count_draw(bool instanced)
 {
-    if (g_text_shader_program == 0)
+    g_frame_stats.draw_calls++;
+    if (instanced)
     {
-        g_text_shader_program = rgfx_create_shader_program(
-            rgfx_internal_default_text_vertex_shader(),
-            rgfx_internal_default_text_fragment_shader());
-        if (g_text_shader_program == 0)
-        {
-            return 0;
-        }
+        g_frame_stats.instanced_draw_calls++;
     }
-
-    g_text_shader_refcount++;
-    return g_text_shader_program;
 }
 
-void rgfx_internal_release_text_shader_program(void)
+void rgfx_internal_stats_count_state_change(bool skipped)
 {
-    if (g_text_shader_refcount > 0)
+    if (skipped)
     {
-        g_text_shader_refcount--;
-        if (g_text_shader_refcount == 0 && g_text_shader_program != 0)
-        {
-            glDeleteProgram(g_text_shader_program);
-            g_text_shader_program = 0;
-        }
+        g_frame_stats.redundant_state_changes_skipped++;
+    }
+    else
+    {
+        g_frame_stats.state_changes++;
     }
 }
 
+void rgfx_internal_stats_count_sprites(uint32_t sprites)
+{
+    g_frame_stats.sprites_drawn += sprites;
+}
+
+void rgfx_internal_stats_count_texture_bind(void)
+{
+    g_frame_stats.texture_binds++;
+}
+
+void rgfx_internal_stats_count_texts(uint32_t texts)
+{
+    g_frame_stats.texts_drawn += texts;
+}
+
+void rgfx_clear(float r, float g, float b)
+{
+    glClearColor(r, g, b, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void rgfx_clear_color(color color)
+{
+    glClearColor(color.r, color.g, color.b, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
 rgfx_camera_t* rgfx_internal_get_active_camera(void)
 {
     return g_active_camera;
@@ -697,6 +812,64 @@ void rgfx_internal_set_active_camera(rgfx_camera_t* camera)
     g_active_camera = camera;
 }
 
+static void rgfx_camera_update_matrices(rgfx_camera_t* camera)
+{
+    if (!camera->dirty)
+    {
+        return;
+    }
+
+    vec3 target = { camera->position[0] + camera->forward[0],
+                    camera->position[1] + camera->forward[1],
+                    camera->position[2] + camera->forward[2] };
+
+    mat4x4_look_at(camera->view, camera->position, target, camera->up);
+    mat4x4_perspective(camera->projection, camera->fov, camera->aspect, camera->near, camera->far);
+    mat4x4_mul_simd(camera->view_projection, camera->projection, camera->view);
+
+    camera->dirty = false;
+    camera->revision++;
+}
+
+const rgfx_camera_state_t* rgfx_internal_camera_state(void)
+{
+    rgfx_camera_t* camera = g_active_camera;
+    if (camera)
+    {
+        rgfx_camera_update_matrices(camera);
+    }
+
+    if (g_camera_state_valid && g_camera_state_source == camera &&
+        (!camera || g_camera_state_source_revision == camera->revision))
+    {
+        return &g_camera_state;
+    }
+
+    if (camera)
+    {
+        mat4x4_dup(g_camera_state.view, camera->view);
+        mat4x4_dup(g_camera_state.projection, camera->projection);
+        mat4x4_dup(g_camera_state.view_projection, camera->view_projection);
+        g_camera_state_source_revision = camera->revision;
+    }
+    else
+    {
+        mat4x4_identity(g_camera_state.view);
+        mat4x4_identity(g_camera_state.projection);
+        mat4x4_identity(g_camera_state.view_projection);
+    }
+
+    // Programs start at revision 0, so never hand that value out
+    if (++g_camera_state.revision == 0)
+    {
+        g_camera_state.revision = 1;
+    }
+    g_camera_state_source = camera;
+    g_camera_state_valid  = true;
+
+    return &g_camera_state;
+}
+
 rgfx_camera_t* rgfx_camera_create(const rgfx_camera_desc_t* desc)
 {
     if (!desc)
@@ -721,6 +894,7 @@ rgfx_camera_t* rgfx_camera_create(const rgfx_camera_desc_t* desc)
     camera->aspect = desc->aspect;
     camera->near   = desc->near;
     camera->far    = desc->far;
+    camera->dirty  = true;
 
     return camera;
 }
@@ -733,6 +907,10 @@ void rgfx_camera_destroy(rgfx_camera_t* camera)
         {
             g_active_camera = NULL;
         }
+        if (g_camera_state_source == camera)
+        {
+            g_camera_state_valid = false;
+        }
         free(camera);
     }
 }
@@ -745,6 +923,7 @@ void rgfx_camera_set_position(rgfx_camera_t* camera, vec3 position)
     }
 
     vec3_dup(camera->position, position);
+    camera->dirty = true;
 }
 
 void rgfx_camera_set_direction(rgfx_camera_t* camera, vec3 direction)
@@ -755,6 +934,7 @@ void rgfx_camera_set_direction(rgfx_camera_t* camera, vec3 direction)
     }
 
     vec3_norm(camera->forward, direction);
+    camera->dirty = true;
 }
 
 void rgfx_camera_look_at(rgfx_camera_t* camera, vec3 target)
@@ -767,6 +947,7 @@ void rgfx_camera_look_at(rgfx_camera_t* camera, vec3 target)
     vec3 direction;
     vec3_sub(direction, target, camera->position);
     vec3_norm(camera->forward, direction);
+    camera->dirty = true;
 }
 
 void rgfx_camera_move(rgfx_camera_t* camera, vec3 offset)
@@ -779,6 +960,7 @@ void rgfx_camera_move(rgfx_camera_t* camera, vec3 offset)
     camera->position[0] += offset[0];
     camera->position[1] += offset[1];
     camera->position[2] += offset[2];
+    camera->dirty = true;
 }
 
 void rgfx_camera_rotate(rgfx_camera_t* camera, float yaw, float pitch)
@@ -799,15 +981,16 @@ void rgfx_camera_rotate(rgfx_camera_t* camera, float yaw, float pitch)
     mat4x4_identity(rotatePitch);
     mat4x4_rotate_X(rotatePitch, rotatePitch, pitch);
 
-    mat4x4_mul(rotation, rotateYaw, rotatePitch);
+    mat4x4_mul_simd(rotation, rotateYaw, rotatePitch);
 
     vec4 forward4 = { camera->forward[0], camera->forward[1], camera->forward[2], 0.0f };
     vec4 transformed;
-    mat4x4_mul_vec4(transformed, rotation, forward4);
+    mat4x4_mul_vec4_simd(transformed, rotation, forward4);
     camera->forward[0] = transformed[0];
     camera->forward[1] = transformed[1];
     camera->forward[2] = transformed[2];
     vec3_norm(camera->forward, camera->forward);
+    camera->dirty = true;
 }
 
 void rgfx_camera_get_matrices(const rgfx_camera_t* camera, mat4x4 view, mat4x4 projection)
@@ -817,12 +1000,11 @@ void rgfx_camera_get_matrices(const rgfx_camera_t* camera, mat4x4 view, mat4x4 p
         return;
     }
 
-    vec3 target = { camera->position[0] + camera->forward[0],
-                    camera->position[1] + camera->forward[1],
-                    camera->position[2] + camera->forward[2] };
+    // The cached matrices are refreshed lazily; the camera itself was never created const
+    rgfx_camera_update_matrices((rgfx_camera_t*)camera);
 
-    mat4x4_look_at(view, camera->position, target, camera->up);
-    mat4x4_perspective(projection, camera->fov, camera->aspect, camera->near, camera->far);
+    mat4x4_dup(view, camera->view);
+    mat4x4_dup(projection, camera->projection);
 }
 
 void rgfx_set_active_camera(rgfx_camera_t* camera)
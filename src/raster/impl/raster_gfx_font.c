@@ -0,0 +1,869 @@
+#include "raster_gfx_internal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <stb/stb_truetype.h>
+
+#define RGFX_GLYPH_ATLAS_WIDTH          512
+#define RGFX_GLYPH_ATLAS_INITIAL_HEIGHT 256
+#define RGFX_GLYPH_ATLAS_MAX_HEIGHT     2048
+#define RGFX_GLYPH_ATLAS_PADDING        1
+#define RGFX_GLYPH_TABLE_INITIAL_SIZE   128u
+
+static struct
+{
+    rgfx_font_t** entries;
+    uint32_t      count;
+    uint32_t      capacity;
+} g_fonts = { 0 };
+
+static struct
+{
+    rgfx_glyph_atlas_t** entries;
+    uint32_t             count;
+    uint32_t             capacity;
+} g_atlases = { 0 };
+
+static struct
+{
+    unsigned int EBO;
+    uint32_t     quad_capacity;
+} g_glyph_indices = { 0 };
+
+static uint32_t rgfx_hash_font_path(const char* path)
+{
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)path; *p; ++p)
+    {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static inline uint32_t rgfx_glyph_bucket(int codepoint, uint32_t capacity)
+{
+    return ((uint32_t)codepoint * 2654435761u) & (capacity - 1u);
+}
+
+static bool rgfx_font_build_tables(rgfx_font_metrics_t* metrics)
+{
+    const stbtt_fontinfo* info  = metrics->info;
+    const float           scale = metrics->scale;
+
+    for (int codepoint = 0; codepoint < RGFX_FONT_ASCII_COUNT; ++codepoint)
+    {
+        int glyph_index = stbtt_FindGlyphIndex(info, codepoint);
+        int advance     = 0;
+        int lsb         = 0;
+        stbtt_GetGlyphHMetrics(info, glyph_index, &advance, &lsb);
+
+        metrics->ascii_glyph_index[codepoint] = glyph_index;
+        metrics->ascii_advance[codepoint]     = (int)(advance * scale + 0.5f);
+    }
+
+    metrics->has_kerning = info->kern != 0 || info->gpos != 0;
+    if (metrics->has_kerning)
+    {
+        metrics->kerning = (int16_t*)malloc((size_t)RGFX_FONT_KERN_COUNT * RGFX_FONT_KERN_COUNT * sizeof(int16_t));
+        if (!metrics->kerning)
+        {
+            return false;
+        }
+
+        for (int left = 0; left < RGFX_FONT_KERN_COUNT; ++left)
+        {
+            int left_glyph = metrics->ascii_glyph_index[RGFX_FONT_KERN_FIRST + left];
+            for (int right = 0; right < RGFX_FONT_KERN_COUNT; ++right)
+            {
+                int right_glyph = metrics->ascii_glyph_index[RGFX_FONT_KERN_FIRST + right];
+                int kern        = stbtt_GetGlyphKernAdvance(info, left_glyph, right_glyph);
+                metrics->kerning[left * RGFX_FONT_KERN_COUNT + right] = (int16_t)(int)(kern * scale + 0.5f);
+            }
+        }
+    }
+
+    return true;
+}
+
+static rgfx_glyph_metrics_t* rgfx_font_glyph_metrics(rgfx_font_metrics_t* metrics, int codepoint)
+{
+    if (codepoint < 0)
+    {
+        return NULL;
+    }
+
+    if (metrics->glyph_capacity)
+    {
+        uint32_t bucket = rgfx_glyph_bucket(codepoint, metrics->glyph_capacity);
+        while (metrics->glyphs[bucket].codepoint >= 0)
+        {
+            if (metrics->glyphs[bucket].codepoint == codepoint)
+            {
+                return &metrics->glyphs[bucket];
+            }
+            bucket = (bucket + 1u) & (metrics->glyph_capacity - 1u);
+        }
+    }
+
+    if ((metrics->glyph_count + 1u) * 2u > metrics->glyph_capacity)
+    {
+        uint32_t              new_capacity = metrics->glyph_capacity ? metrics->glyph_capacity * 2u : 64u;
+        rgfx_glyph_metrics_t* glyphs = (rgfx_glyph_metrics_t*)malloc((size_t)new_capacity * sizeof(rgfx_glyph_metrics_t));
+        if (!glyphs)
+        {
+            return NULL;
+        }
+        for (uint32_t i = 0; i < new_capacity; ++i)
+        {
+            glyphs[i].codepoint = -1;
+        }
+
+        for (uint32_t i = 0; i < metrics->glyph_capacity; ++i)
+        {
+            if (metrics->glyphs[i].codepoint < 0)
+            {
+                continue;
+            }
+
+            uint32_t bucket = rgfx_glyph_bucket(metrics->glyphs[i].codepoint, new_capacity);
+            while (glyphs[bucket].codepoint >= 0)
+            {
+                bucket = (bucket + 1u) & (new_capacity - 1u);
+            }
+            glyphs[bucket] = metrics->glyphs[i];
+        }
+
+        free(metrics->glyphs);
+        metrics->glyphs         = glyphs;
+        metrics->glyph_capacity = new_capacity;
+    }
+
+    uint32_t bucket = rgfx_glyph_bucket(codepoint, metrics->glyph_capacity);
+    while (metrics->glyphs[bucket].codepoint >= 0)
+    {
+        bucket = (bucket + 1u) & (metrics->glyph_capacity - 1u);
+    }
+
+    rgfx_glyph_metrics_t* entry   = &metrics->glyphs[bucket];
+    int                   advance = 0;
+    int                   lsb     = 0;
+    entry->codepoint   = codepoint;
+    entry->glyph_index = stbtt_FindGlyphIndex(metrics->info, codepoint);
+    stbtt_GetGlyphHMetrics(metrics->info, entry->glyph_index, &advance, &lsb);
+    entry->advance = (int)(advance * metrics->scale + 0.5f);
+
+    metrics->glyph_count++;
+    return entry;
+}
+
+int rgfx_internal_font_glyph_advance(rgfx_font_metrics_t* metrics, int codepoint)
+{
+    if ((unsigned)codepoint < RGFX_FONT_ASCII_COUNT)
+    {
+        return metrics->ascii_advance[codepoint];
+    }
+
+    const rgfx_glyph_metrics_t* glyph = rgfx_font_glyph_metrics(metrics, codepoint);
+    return glyph ? glyph->advance : 0;
+}
+
+static int rgfx_font_glyph_index(rgfx_font_metrics_t* metrics, int codepoint)
+{
+    if ((unsigned)codepoint < RGFX_FONT_ASCII_COUNT)
+    {
+        return metrics->ascii_glyph_index[codepoint];
+    }
+
+    const rgfx_glyph_metrics_t* glyph = rgfx_font_glyph_metrics(metrics, codepoint);
+    return glyph ? glyph->glyph_index : 0;
+}
+
+/* Pairs outside the dense table still skip the cmap lookups by using cached glyph indices */
+int rgfx_internal_font_glyph_kerning(rgfx_font_metrics_t* metrics, int left, int right)
+{
+    if (!metrics->has_kerning)
+    {
+        return 0;
+    }
+
+    int kern = stbtt_GetGlyphKernAdvance(metrics->info,
+                                         rgfx_font_glyph_index(metrics, left),
+                                         rgfx_font_glyph_index(metrics, right));
+    return (int)(kern * metrics->scale + 0.5f);
+}
+
+static void rgfx_font_free(rgfx_font_t* font)
+{
+    if (!font)
+    {
+        return;
+    }
+
+    for (int i = 0; i < font->size_count; ++i)
+    {
+        free(font->sizes[i]->kerning);
+        free(font->sizes[i]->glyphs);
+        free(font->sizes[i]);
+    }
+    free(font->sizes);
+    free(font->info);
+    rasset_close(&font->file);
+    free(font->path);
+    free(font);
+}
+
+static rgfx_font_t* rgfx_font_load(const char* path, uint32_t path_hash)
+{
+    rgfx_font_t* font = (rgfx_font_t*)calloc(1, sizeof(rgfx_font_t));
+    if (!font)
+    {
+        return NULL;
+    }
+
+    if (!rasset_open(path, &font->file))
+    {
+        rlog_error("rgfx: failed to read font %s", path);
+        free(font);
+        return NULL;
+    }
+
+    font->path = (char*)malloc(strlen(path) + 1);
+    font->info = (stbtt_fontinfo*)calloc(1, sizeof(stbtt_fontinfo));
+    if (!font->path || !font->info)
+    {
+        rgfx_font_free(font);
+        return NULL;
+    }
+
+    if (!stbtt_InitFont(font->info, font->file.data, stbtt_GetFontOffsetForIndex(font->file.data, 0)))
+    {
+        rlog_error("rgfx: failed to parse font %s", path);
+        rgfx_font_free(font);
+        return NULL;
+    }
+
+    strcpy(font->path, path);
+    font->path_hash = path_hash;
+    return font;
+}
+
+static rgfx_font_t* rgfx_font_find(const char* path, uint32_t hash)
+{
+    for (uint32_t i = 0; i < g_fonts.count; ++i)
+    {
+        rgfx_font_t* font = g_fonts.entries[i];
+        if (font->path_hash == hash && strcmp(font->path, path) == 0)
+        {
+            return font;
+        }
+    }
+    return NULL;
+}
+
+static bool rgfx_font_register(rgfx_font_t* font)
+{
+    if (g_fonts.count == g_fonts.capacity)
+    {
+        uint32_t      new_capacity = g_fonts.capacity ? g_fonts.capacity * 2u : 8u;
+        rgfx_font_t** entries      = (rgfx_font_t**)realloc(g_fonts.entries, (size_t)new_capacity * sizeof(rgfx_font_t*));
+        if (!entries)
+        {
+            return false;
+        }
+        g_fonts.entries  = entries;
+        g_fonts.capacity = new_capacity;
+    }
+
+    font->refcount = 1;
+    g_fonts.entries[g_fonts.count++] = font;
+    return true;
+}
+
+rgfx_font_t* rgfx_internal_font_acquire(const char* path)
+{
+    if (!path)
+    {
+        return NULL;
+    }
+
+    uint32_t     hash = rgfx_hash_font_path(path);
+    rgfx_font_t* font = rgfx_font_find(path, hash);
+    if (font)
+    {
+        font->refcount++;
+        return font;
+    }
+
+    font = rgfx_font_load(path, hash);
+    if (font && !rgfx_font_register(font))
+    {
+        rgfx_font_free(font);
+        return NULL;
+    }
+    return font;
+}
+
+rgfx_font_t* rgfx_internal_font_load_detached(const char* path)
+{
+    return path ? rgfx_font_load(path, rgfx_hash_font_path(path)) : NULL;
+}
+
+rgfx_font_t* rgfx_internal_font_adopt(rgfx_font_t* font)
+{
+    if (!font)
+    {
+        return NULL;
+    }
+
+    // Another text may have loaded the same file while this one was on a worker
+    rgfx_font_t* existing = rgfx_font_find(font->path, font->path_hash);
+    if (existing)
+    {
+        rgfx_font_free(font);
+        existing->refcount++;
+        return existing;
+    }
+
+    if (!rgfx_font_register(font))
+    {
+        rgfx_font_free(font);
+        return NULL;
+    }
+    return font;
+}
+
+void rgfx_internal_font_discard(rgfx_font_t* font)
+{
+    rgfx_font_free(font);
+}
+
+void rgfx_internal_font_release(rgfx_font_t* font)
+{
+    if (!font || --font->refcount > 0)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < g_fonts.count; ++i)
+    {
+        if (g_fonts.entries[i] == font)
+        {
+            g_fonts.entries[i] = g_fonts.entries[--g_fonts.count];
+            break;
+        }
+    }
+
+    rgfx_font_free(font);
+}
+
+rgfx_font_metrics_t* rgfx_internal_font_metrics(rgfx_font_t* font, float pixel_height)
+{
+    if (!font || pixel_height <= 0.0f)
+    {
+        return NULL;
+    }
+
+    for (int i = 0; i < font->size_count; ++i)
+    {
+        if (font->sizes[i]->pixel_height == pixel_height)
+        {
+            return font->sizes[i];
+        }
+    }
+
+    if (font->size_count == font->size_capacity)
+    {
+        int                   new_capacity = font->size_capacity ? font->size_capacity * 2 : 4;
+        rgfx_font_metrics_t** sizes =
+            (rgfx_font_metrics_t**)realloc(font->sizes, (size_t)new_capacity * sizeof(rgfx_font_metrics_t*));
+        if (!sizes)
+        {
+            return NULL;
+        }
+        font->sizes         = sizes;
+        font->size_capacity = new_capacity;
+    }
+
+    rgfx_font_metrics_t* metrics = (rgfx_font_metrics_t*)calloc(1, sizeof(rgfx_font_metrics_t));
+    if (!metrics)
+    {
+        return NULL;
+    }
+
+    int ascent, descent, line_gap;
+    stbtt_GetFontVMetrics(font->info, &ascent, &descent, &line_gap);
+
+    metrics->pixel_height = pixel_height;
+    metrics->scale        = stbtt_ScaleForPixelHeight(font->info, pixel_height);
+    metrics->ascent       = (int)(ascent * metrics->scale + 0.5f);
+    metrics->descent      = (int)(descent * metrics->scale - 0.5f);
+    metrics->line_gap     = (int)(line_gap * metrics->scale + 0.5f);
+    metrics->info         = font->info;
+
+    if (!rgfx_font_build_tables(metrics))
+    {
+        free(metrics->kerning);
+        free(metrics->glyphs);
+        free(metrics);
+        return NULL;
+    }
+
+    font->sizes[font->size_count++] = metrics;
+    return metrics;
+}
+
+static bool rgfx_glyph_table_reserve(rgfx_glyph_atlas_t* atlas, uint32_t count)
+{
+    if (atlas->glyph_capacity && count * 2u <= atlas->glyph_capacity)
+    {
+        return true;
+    }
+
+    uint32_t new_capacity = atlas->glyph_capacity ? atlas->glyph_capacity * 2u : RGFX_GLYPH_TABLE_INITIAL_SIZE;
+    while (count * 2u > new_capacity)
+    {
+        new_capacity *= 2u;
+    }
+
+    rgfx_glyph_t* glyphs = (rgfx_glyph_t*)malloc((size_t)new_capacity * sizeof(rgfx_glyph_t));
+    if (!glyphs)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < new_capacity; ++i)
+    {
+        glyphs[i].codepoint = -1;
+    }
+
+    for (uint32_t i = 0; i < atlas->glyph_capacity; ++i)
+    {
+        if (atlas->glyphs[i].codepoint < 0)
+        {
+            continue;
+        }
+
+        uint32_t bucket = rgfx_glyph_bucket(atlas->glyphs[i].codepoint, new_capacity);
+        while (glyphs[bucket].codepoint >= 0)
+        {
+            bucket = (bucket + 1u) & (new_capacity - 1u);
+        }
+        glyphs[bucket] = atlas->glyphs[i];
+    }
+
+    free(atlas->glyphs);
+    atlas->glyphs         = glyphs;
+    atlas->glyph_capacity = new_capacity;
+    return true;
+}
+
+static rgfx_glyph_t* rgfx_glyph_table_slot(rgfx_glyph_atlas_t* atlas, int codepoint)
+{
+    uint32_t bucket = rgfx_glyph_bucket(codepoint, atlas->glyph_capacity);
+    while (atlas->glyphs[bucket].codepoint >= 0 && atlas->glyphs[bucket].codepoint != codepoint)
+    {
+        bucket = (bucket + 1u) & (atlas->glyph_capacity - 1u);
+    }
+    return &atlas->glyphs[bucket];
+}
+
+/* Grows the pending upload rect to cover a newly rasterized glyph */
+static void rgfx_glyph_atlas_mark_dirty(rgfx_glyph_atlas_t* atlas, int x, int y, int width, int height)
+{
+    if (atlas->dirty_x1 <= atlas->dirty_x0)
+    {
+        atlas->dirty_x0 = x;
+        atlas->dirty_y0 = y;
+        atlas->dirty_x1 = x + width;
+        atlas->dirty_y1 = y + height;
+        return;
+    }
+
+    atlas->dirty_x0 = x < atlas->dirty_x0 ? x : atlas->dirty_x0;
+    atlas->dirty_y0 = y < atlas->dirty_y0 ? y : atlas->dirty_y0;
+    atlas->dirty_x1 = x + width > atlas->dirty_x1 ? x + width : atlas->dirty_x1;
+    atlas->dirty_y1 = y + height > atlas->dirty_y1 ? y + height : atlas->dirty_y1;
+}
+
+static void rgfx_glyph_atlas_clear_dirty(rgfx_glyph_atlas_t* atlas)
+{
+    atlas->dirty_x0 = 0;
+    atlas->dirty_y0 = 0;
+    atlas->dirty_x1 = 0;
+    atlas->dirty_y1 = 0;
+}
+
+void rgfx_internal_glyph_atlas_flush(rgfx_glyph_atlas_t* atlas)
+{
+    if (!atlas || atlas->dirty_x1 <= atlas->dirty_x0)
+    {
+        return;
+    }
+
+    int x      = atlas->dirty_x0;
+    int y      = atlas->dirty_y0;
+    int width  = atlas->dirty_x1 - atlas->dirty_x0;
+    int height = atlas->dirty_y1 - atlas->dirty_y0;
+
+    rgfx_internal_bind_texture(0, atlas->texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, atlas->width);
+    glTexSubImage2D(GL_TEXTURE_2D,
+                    0,
+                    x,
+                    y,
+                    width,
+                    height,
+                    GL_RED,
+                    GL_UNSIGNED_BYTE,
+                    atlas->pixels + (size_t)y * (size_t)atlas->width + (size_t)x);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    rgfx_glyph_atlas_clear_dirty(atlas);
+}
+
+static bool rgfx_glyph_atlas_allocate_texture(rgfx_glyph_atlas_t* atlas)
+{
+    if (!atlas->texture)
+    {
+        glGenTextures(1, &atlas->texture);
+        if (!atlas->texture)
+        {
+            return false;
+        }
+    }
+
+    rgfx_internal_bind_texture(0, atlas->texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, atlas->width, atlas->height, 0, GL_RED, GL_UNSIGNED_BYTE, atlas->pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // The full upload above already carries every pending glyph
+    rgfx_glyph_atlas_clear_dirty(atlas);
+    atlas->generation++;
+    return true;
+}
+
+static bool rgfx_glyph_atlas_grow(rgfx_glyph_atlas_t* atlas)
+{
+    if (atlas->height >= RGFX_GLYPH_ATLAS_MAX_HEIGHT)
+    {
+        return false;
+    }
+
+    int            new_height = atlas->height * 2;
+    unsigned char* pixels     = (unsigned char*)realloc(atlas->pixels, (size_t)atlas->width * (size_t)new_height);
+    if (!pixels)
+    {
+        return false;
+    }
+
+    // Existing rows keep their place; only the new space above them needs clearing
+    memset(pixels + (size_t)atlas->width * (size_t)atlas->height, 0, (size_t)atlas->width * (size_t)(new_height - atlas->height));
+    atlas->pixels = pixels;
+    atlas->height = new_height;
+
+    return rgfx_glyph_atlas_allocate_texture(atlas);
+}
+
+static void rgfx_glyph_atlas_free(rgfx_glyph_atlas_t* atlas)
+{
+    if (!atlas)
+    {
+        return;
+    }
+
+    if (atlas->texture)
+    {
+        rgfx_internal_state_forget_texture(atlas->texture);
+        glDeleteTextures(1, &atlas->texture);
+    }
+    rgfx_internal_font_release(atlas->font);
+    free(atlas->pixels);
+    rgfx_internal_skyline_free(&atlas->skyline);
+    free(atlas->glyphs);
+    free(atlas);
+}
+
+static rgfx_glyph_atlas_t* rgfx_glyph_atlas_create(rgfx_font_t* font, float pixel_height, bool sdf)
+{
+    rgfx_glyph_atlas_t* atlas = (rgfx_glyph_atlas_t*)calloc(1, sizeof(rgfx_glyph_atlas_t));
+    if (!atlas)
+    {
+        return NULL;
+    }
+
+    // The atlas keeps its font alive for as long as glyphs may still be rasterized from it
+    font->refcount++;
+    atlas->font    = font;
+    atlas->width   = RGFX_GLYPH_ATLAS_WIDTH;
+    atlas->height  = RGFX_GLYPH_ATLAS_INITIAL_HEIGHT;
+    atlas->pixels  = (unsigned char*)calloc((size_t)atlas->width * (size_t)atlas->height, 1);
+    if (!atlas->pixels || !rgfx_internal_skyline_init(&atlas->skyline, atlas->width) || !rgfx_glyph_table_reserve(atlas, 1u))
+    {
+        rgfx_glyph_atlas_free(atlas);
+        return NULL;
+    }
+
+    atlas->pixel_height = pixel_height;
+    atlas->sdf          = sdf;
+
+    if (!rgfx_glyph_atlas_allocate_texture(atlas))
+    {
+        rlog_error("rgfx: failed to create glyph atlas texture for %s", font->path);
+        rgfx_glyph_atlas_free(atlas);
+        return NULL;
+    }
+
+    return atlas;
+}
+
+rgfx_glyph_atlas_t* rgfx_internal_glyph_atlas_acquire(rgfx_font_t* font, float pixel_height, bool sdf)
+{
+    if (!font || pixel_height <= 0.0f)
+    {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < g_atlases.count; ++i)
+    {
+        rgfx_glyph_atlas_t* atlas = g_atlases.entries[i];
+        if (atlas->font == font && atlas->pixel_height == pixel_height && atlas->sdf == sdf)
+        {
+            atlas->refcount++;
+            return atlas;
+        }
+    }
+
+    if (g_atlases.count == g_atlases.capacity)
+    {
+        uint32_t             new_capacity = g_atlases.capacity ? g_atlases.capacity * 2u : 8u;
+        rgfx_glyph_atlas_t** entries =
+            (rgfx_glyph_atlas_t**)realloc(g_atlases.entries, (size_t)new_capacity * sizeof(rgfx_glyph_atlas_t*));
+        if (!entries)
+        {
+            return NULL;
+        }
+        g_atlases.entries  = entries;
+        g_atlases.capacity = new_capacity;
+    }
+
+    rgfx_glyph_atlas_t* atlas = rgfx_glyph_atlas_create(font, pixel_height, sdf);
+    if (!atlas)
+    {
+        return NULL;
+    }
+
+    atlas->refcount = 1;
+    g_atlases.entries[g_atlases.count++] = atlas;
+    return atlas;
+}
+
+void rgfx_internal_glyph_atlas_release(rgfx_glyph_atlas_t* atlas)
+{
+    if (!atlas || --atlas->refcount > 0)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < g_atlases.count; ++i)
+    {
+        if (g_atlases.entries[i] == atlas)
+        {
+            g_atlases.entries[i] = g_atlases.entries[--g_atlases.count];
+            break;
+        }
+    }
+
+    rgfx_glyph_atlas_free(atlas);
+}
+
+const rgfx_glyph_t* rgfx_internal_glyph_atlas_get(rgfx_glyph_atlas_t* atlas, int codepoint)
+{
+    if (!atlas || codepoint < 0)
+    {
+        return NULL;
+    }
+
+    rgfx_glyph_t* glyph = rgfx_glyph_table_slot(atlas, codepoint);
+    if (glyph->codepoint == codepoint)
+    {
+        return glyph;
+    }
+
+    if (!rgfx_glyph_table_reserve(atlas, atlas->glyph_count + 1u))
+    {
+        return NULL;
+    }
+    glyph = rgfx_glyph_table_slot(atlas, codepoint);
+
+    const stbtt_fontinfo* font  = atlas->font->info;
+    float                 scale = stbtt_ScaleForPixelHeight(font, atlas->pixel_height);
+
+    int            x0         = 0;
+    int            y0         = 0;
+    int            width      = 0;
+    int            height     = 0;
+    unsigned char* sdf_bitmap = NULL;
+    if (atlas->sdf)
+    {
+        // onedge / padding maps the padding band onto the full 0..onedge distance range
+        sdf_bitmap = stbtt_GetCodepointSDF(font,
+                                           scale,
+                                           codepoint,
+                                           RGFX_GLYPH_SDF_PADDING,
+                                           RGFX_GLYPH_SDF_ONEDGE,
+                                           (float)RGFX_GLYPH_SDF_ONEDGE / (float)RGFX_GLYPH_SDF_PADDING,
+                                           &width,
+                                           &height,
+                                           &x0,
+                                           &y0);
+        if (!sdf_bitmap)
+        {
+            width  = 0;
+            height = 0;
+        }
+    }
+    else
+    {
+        int x1, y1;
+        stbtt_GetCodepointBitmapBox(font, codepoint, scale, scale, &x0, &y0, &x1, &y1);
+        width  = x1 - x0;
+        height = y1 - y0;
+    }
+
+    rgfx_glyph_t entry = { 0 };
+    entry.codepoint    = codepoint;
+    entry.offset_x     = x0;
+    entry.offset_y     = y0;
+
+    if (width > 0 && height > 0)
+    {
+        int x = 0;
+        int y = 0;
+        while (!rgfx_internal_skyline_pack(&atlas->skyline,
+                                           atlas->width,
+                                           atlas->height,
+                                           width + RGFX_GLYPH_ATLAS_PADDING,
+                                           height + RGFX_GLYPH_ATLAS_PADDING,
+                                           &x,
+                                           &y))
+        {
+            if (!rgfx_glyph_atlas_grow(atlas))
+            {
+                rlog_error("rgfx: glyph atlas for %s at %.1fpx is full", atlas->font->path, atlas->pixel_height);
+                stbtt_FreeSDF(sdf_bitmap, NULL);
+                return NULL;
+            }
+        }
+
+        unsigned char* dst = atlas->pixels + (size_t)y * (size_t)atlas->width + (size_t)x;
+        if (sdf_bitmap)
+        {
+            for (int row = 0; row < height; ++row)
+            {
+                memcpy(dst + (size_t)row * (size_t)atlas->width, sdf_bitmap + (size_t)row * (size_t)width, (size_t)width);
+            }
+        }
+        else
+        {
+            stbtt_MakeCodepointBitmap(font, dst, width, height, atlas->width, scale, scale, codepoint);
+        }
+        rgfx_glyph_atlas_mark_dirty(atlas, x, y, width, height);
+
+        entry.x0 = x;
+        entry.y0 = y;
+        entry.x1 = x + width;
+        entry.y1 = y + height;
+    }
+
+    stbtt_FreeSDF(sdf_bitmap, NULL);
+
+    *glyph = entry;
+    atlas->glyph_count++;
+    return glyph;
+}
+
+unsigned int rgfx_internal_glyph_index_buffer(uint32_t quad_count)
+{
+    if (!g_glyph_indices.EBO)
+    {
+        glGenBuffers(1, &g_glyph_indices.EBO);
+        if (!g_glyph_indices.EBO)
+        {
+            return 0;
+        }
+    }
+
+    if (quad_count <= g_glyph_indices.quad_capacity)
+    {
+        return g_glyph_indices.EBO;
+    }
+
+    uint32_t new_capacity = g_glyph_indices.quad_capacity ? g_glyph_indices.quad_capacity : 64u;
+    while (new_capacity < quad_count)
+    {
+        new_capacity *= 2u;
+    }
+
+    unsigned int* indices = (unsigned int*)malloc((size_t)new_capacity * RGFX_QUAD_INDEX_COUNT * sizeof(unsigned int));
+    if (!indices)
+    {
+        return 0;
+    }
+
+    for (uint32_t quad = 0; quad < new_capacity; ++quad)
+    {
+        unsigned int  base = quad * 4u;
+        unsigned int* out  = indices + (size_t)quad * RGFX_QUAD_INDEX_COUNT;
+        out[0]             = base + 0u;
+        out[1]             = base + 1u;
+        out[2]             = base + 2u;
+        out[3]             = base + 2u;
+        out[4]             = base + 3u;
+        out[5]             = base + 0u;
+    }
+
+    // Callers hold the VAO that should reference this buffer bound, since the binding is VAO state
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_glyph_indices.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 (GLsizeiptr)((size_t)new_capacity * RGFX_QUAD_INDEX_COUNT * sizeof(unsigned int)),
+                 indices,
+                 GL_STATIC_DRAW);
+    free(indices);
+
+    g_glyph_indices.quad_capacity = new_capacity;
+    return g_glyph_indices.EBO;
+}
+
+void rgfx_internal_font_shutdown(void)
+{
+    // Atlases drop their font references as they go, so they are freed before the fonts
+    for (uint32_t i = 0; i < g_atlases.count; ++i)
+    {
+        rgfx_glyph_atlas_free(g_atlases.entries[i]);
+    }
+    free(g_atlases.entries);
+    memset(&g_atlases, 0, sizeof(g_atlases));
+
+    for (uint32_t i = 0; i < g_fonts.count; ++i)
+    {
+        rgfx_font_free(g_fonts.entries[i]);
+    }
+    free(g_fonts.entries);
+    memset(&g_fonts, 0, sizeof(g_fonts));
+
+    if (g_glyph_indices.EBO)
+    {
+        glDeleteBuffers(1, &g_glyph_indices.EBO);
+    }
+    memset(&g_glyph_indices, 0, sizeof(g_glyph_indices));
+}
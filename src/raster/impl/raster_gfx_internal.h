@@ -3,6 +3,7 @@
 #include "raster/raster_gfx.h"
 #include "raster/raster_math.h"
 #include "raster/raster_app.h"
+#include "raster/raster_asset.h"
 #include "raster/raster_log.h"
 
 #include <glad/glad.h>
@@ -14,7 +15,173 @@
 
 typedef struct stbtt_fontinfo stbtt_fontinfo;
 
-#define RGFX_MAX_TEXT_LENGTH 256
+#define RGFX_HANDLE_INDEX_MASK       0xFFFFu
+#define RGFX_HANDLE_GENERATION_SHIFT 16u
+
+static inline uint32_t rgfx_handle_index(uint32_t handle)
+{
+    return (handle & RGFX_HANDLE_INDEX_MASK) - 1u;
+}
+
+static inline uint32_t rgfx_handle_generation(uint32_t handle)
+{
+    return handle >> RGFX_HANDLE_GENERATION_SHIFT;
+}
+
+static inline uint32_t rgfx_make_handle(uint32_t index, uint32_t generation)
+{
+    return ((generation & RGFX_HANDLE_INDEX_MASK) << RGFX_HANDLE_GENERATION_SHIFT) | (index + 1u);
+}
+
+static inline uint32_t rgfx_next_generation(uint32_t generation)
+{
+    generation = (generation + 1u) & RGFX_HANDLE_INDEX_MASK;
+    if (generation == 0u)
+    {
+        generation = 1u;
+    }
+    return generation;
+}
+
+#define RGFX_ATTRIB_POSITION       0
+#define RGFX_ATTRIB_TEXCOORD       1
+#define RGFX_ATTRIB_INSTANCE_MODEL 2 /* mat4 occupies locations 2..5 */
+#define RGFX_ATTRIB_INSTANCE_COLOR 6
+#define RGFX_ATTRIB_INSTANCE_SIZE  7
+#define RGFX_ATTRIB_VERTEX_COLOR   8
+#define RGFX_ATTRIB_INSTANCE_UV    9 /* atlas sub-rect: offset xy, scale zw */
+
+typedef enum
+{
+    RGFX_UNIFORM_SLOT_MODEL,
+    RGFX_UNIFORM_SLOT_VIEW,
+    RGFX_UNIFORM_SLOT_PROJECTION,
+    RGFX_UNIFORM_SLOT_COLOR,
+    RGFX_UNIFORM_SLOT_TIME,
+    RGFX_UNIFORM_SLOT_SIZE,
+    RGFX_UNIFORM_SLOT_USE_TEXTURE,
+    RGFX_UNIFORM_SLOT_TEXTURE,
+    RGFX_UNIFORM_SLOT_UV_RECT,
+    RGFX_UNIFORM_SLOT_COUNT
+} rgfx_uniform_slot_t;
+
+typedef struct
+{
+    char*    name;
+    uint32_t hash;
+    int      location;
+    GLenum   type;
+    bool     applied; /* holds a sprite's value rather than the link-time zero */
+} rgfx_program_uniform_t;
+
+/* Built once when a program is linked; draws index slots[] instead of querying GL by name */
+typedef struct
+{
+    unsigned int            program;
+    int                     slots[RGFX_UNIFORM_SLOT_COUNT];
+    bool                    instanced;
+    rgfx_program_uniform_t* uniforms;
+    int                     uniform_count;
+    int                     applied_count; /* uniforms[] entries with applied set */
+    uint64_t                source_hash; /* set for programs owned by the shared program cache */
+    char*                   sources;     /* cached programs: vertex and fragment source, each NUL-terminated */
+    size_t                  sources_size;
+    int                     refcount;
+    bool                    frame_block;     /* declares the RasterFrame uniform block */
+    uint32_t                camera_revision; /* camera state last uploaded to uView/uProjection */
+    uint32_t                frame_index;     /* frame whose uTime was last uploaded */
+} rgfx_program_info_t;
+
+typedef struct
+{
+    int x0, y0, x1, y1;       /* rect in the atlas, pixels; empty for blank glyphs */
+    int offset_x, offset_y;   /* bitmap box origin relative to the pen position on the baseline */
+    int codepoint;
+} rgfx_glyph_t;
+
+typedef struct
+{
+    int x, y, width;
+} rgfx_skyline_node_t;
+
+/* Bottom-left skyline rectangle packer shared by the glyph and sprite atlases */
+typedef struct
+{
+    rgfx_skyline_node_t* nodes;
+    int                  count;
+    int                  capacity;
+} rgfx_skyline_t;
+
+bool rgfx_internal_skyline_init(rgfx_skyline_t* skyline, int bin_width);
+void rgfx_internal_skyline_free(rgfx_skyline_t* skyline);
+bool rgfx_internal_skyline_pack(rgfx_skyline_t* skyline, int bin_width, int bin_height, int width, int height, int* out_x, int* out_y);
+
+#define RGFX_FONT_ASCII_COUNT 128
+#define RGFX_FONT_KERN_FIRST  32 /* the dense kerning table covers printable ASCII pairs */
+#define RGFX_FONT_KERN_COUNT  95
+
+/* Advance of a codepoint outside the ASCII table, held in an open-addressed map */
+typedef struct
+{
+    int codepoint;
+    int glyph_index;
+    int advance;
+} rgfx_glyph_metrics_t;
+
+/* Metrics of a font at one pixel height, rounded the way text layout consumes them */
+typedef struct
+{
+    float                 pixel_height;
+    float                 scale;
+    int                   ascent;
+    int                   descent;
+    int                   line_gap;
+    const stbtt_fontinfo* info;
+    int                   ascii_advance[RGFX_FONT_ASCII_COUNT];
+    int                   ascii_glyph_index[RGFX_FONT_ASCII_COUNT];
+    bool                  has_kerning;
+    int16_t*              kerning; /* RGFX_FONT_KERN_COUNT^2 pairs, left-major */
+    rgfx_glyph_metrics_t* glyphs;
+    uint32_t              glyph_count;
+    uint32_t              glyph_capacity;
+} rgfx_font_metrics_t;
+
+/* A TrueType file loaded and parsed once, shared by every text that names the same path */
+typedef struct rgfx_font
+{
+    char*                 path;
+    uint32_t              path_hash;
+    rasset_view_t         file; /* stbtt reads the TrueType data in place */
+    stbtt_fontinfo*       info;
+    rgfx_font_metrics_t** sizes; /* individually allocated so returned pointers stay valid */
+    int                   size_count;
+    int                   size_capacity;
+    int                   refcount;
+} rgfx_font_t;
+
+/* SDF glyphs are rasterized once at this height and scaled to any text size */
+#define RGFX_GLYPH_SDF_PIXEL_HEIGHT 48.0f
+#define RGFX_GLYPH_SDF_PADDING      6
+#define RGFX_GLYPH_SDF_ONEDGE       128
+
+/* Glyphs of one font at one pixel height, rasterized on first use and shared by every text */
+typedef struct rgfx_glyph_atlas
+{
+    rgfx_font_t*         font;
+    float                pixel_height;
+    bool                 sdf;
+    unsigned int         texture;
+    int                  width;
+    int                  height;
+    uint32_t             generation; /* bumped when the texture grows and normalized UVs change */
+    unsigned char*       pixels;
+    int                  dirty_x0, dirty_y0, dirty_x1, dirty_y1; /* rasterized but not yet uploaded */
+    rgfx_skyline_t       skyline;
+    rgfx_glyph_t*        glyphs;
+    uint32_t             glyph_count;
+    uint32_t             glyph_capacity;
+    int                  refcount;
+} rgfx_glyph_atlas_t;
 
 typedef struct rgfx_sprite rgfx_sprite_t;
 typedef struct rgfx_text   rgfx_text_t;
@@ -22,19 +189,22 @@ typedef struct rgfx_camera rgfx_camera_t;
 
 struct rgfx_sprite
 {
-    rgfx_object_type_t type;
-    rgfx_sprite_handle handle;
-    rtransform_t*      transform;
-    unsigned int       VAO;
-    unsigned int       VBO;
-    unsigned int       EBO;
-    unsigned int       shaderProgram;
-    unsigned int       textureID;
-    bool               hasTexture;
-    vec3               size;
-    color              color;
-    rgfx_uniform_t     uniforms[RGFX_MAX_UNIFORMS];
-    int                uniform_count;
+    rgfx_object_type_t         type;
+    rgfx_sprite_handle         handle;
+    rtransform_t*              transform;
+    unsigned int               shaderProgram;
+    const rgfx_program_info_t* program_info;
+    rgfx_texture_handle        texture;
+    unsigned int               textureID;
+    bool                       hasTexture;
+    bool                       translucent;
+    rgfx_atlas_handle          atlas;
+    float                      uv_rect[4]; /* offset xy, scale zw; the whole texture unless from an atlas */
+    vec3                       size;
+    color                      color;
+    rgfx_uniform_t             uniforms[RGFX_MAX_UNIFORMS];
+    int                        uniform_locations[RGFX_MAX_UNIFORMS];
+    int                        uniform_count;
 };
 
 struct rgfx_camera
@@ -46,45 +216,231 @@ struct rgfx_camera
     float aspect;
     float near;
     float far;
+
+    bool     dirty;
+    uint32_t revision;
+    mat4x4   view;
+    mat4x4   projection;
+    mat4x4   view_projection;
 };
 
 struct rgfx_text
 {
-    rgfx_object_type_t type;
-    rgfx_text_handle   handle;
-    rtransform_t*      transform;
-    unsigned int       VAO;
-    unsigned int       VBO;
-    unsigned int       EBO;
-    unsigned int       shaderProgram;
-    unsigned int       textureID;
-    stbtt_fontinfo*    font_info;
-    unsigned char*     font_buffer;
-    unsigned char*     font_bitmap;
-    char               text[RGFX_MAX_TEXT_LENGTH];
-    float              font_size;
-    color              text_color;
-    int                bitmap_width;
-    int                bitmap_height;
-    float              line_spacing;
-    int                alignment;
-    unsigned int       index_count;
+    rgfx_object_type_t         type;
+    rgfx_text_handle           handle;
+    rtransform_t*              transform;
+    unsigned int               shaderProgram;
+    const rgfx_program_info_t* program_info;
+    unsigned int               VAO;
+    unsigned int               VBO;
+    rgfx_glyph_atlas_t*        atlas;
+    uint32_t                   atlas_generation;
+    float*                     vertices;
+    uint32_t                   glyph_count;
+    uint32_t                   glyph_capacity;
+    uint32_t                   vbo_capacity; /* glyphs the VBO storage holds; grows with the vertex array */
+    rgfx_font_t*               font;
+    bool                       sdf;
+    char*                      text;
+    uint32_t                   text_length;
+    uint32_t                   text_capacity;
+    void*                      scratch;
+    size_t                     scratch_capacity;
+    float                      font_size;
+    color                      text_color;
+    int                        layout_width;
+    int                        layout_height;
+    float                      line_spacing;
+    int                        alignment;
 };
 
+#define RGFX_QUAD_INDEX_COUNT 6
+
+// Unit quad (position + texcoord, 4 floats per vertex) shared by every sprite and text
+typedef struct
+{
+    unsigned int VAO;
+    unsigned int VBO;
+    unsigned int EBO;
+} rgfx_quad_geometry_t;
+
+const rgfx_quad_geometry_t* rgfx_internal_quad_geometry(void);
+void                        rgfx_internal_quad_bind_vertex_attributes(void);
+
+#define RGFX_MAX_TEXTURE_UNITS 8
+
+/* GL state cache; all gfx code binds through these so redundant changes never reach the driver */
+void rgfx_internal_state_reset(void);
+void rgfx_internal_use_program(unsigned int program);
+void rgfx_internal_bind_vertex_array(unsigned int vertex_array);
+void rgfx_internal_bind_texture(unsigned int unit, unsigned int texture);
+void rgfx_internal_set_blend(bool enabled);
+void rgfx_internal_set_blend_func(GLenum src, GLenum dst);
+void rgfx_internal_set_depth_test(bool enabled);
+void rgfx_internal_set_depth_write(bool enabled);
+void rgfx_internal_state_forget_program(unsigned int program);
+void rgfx_internal_state_forget_vertex_array(unsigned int vertex_array);
+void rgfx_internal_state_forget_texture(unsigned int texture);
+
 const char* rgfx_internal_default_sprite_vertex_shader(void);
 const char* rgfx_internal_default_sprite_fragment_shader(void);
 const char* rgfx_internal_default_text_vertex_shader(void);
 const char* rgfx_internal_default_text_fragment_shader(void);
+const char* rgfx_internal_default_text_sdf_fragment_shader(void);
+const char* rgfx_internal_default_text_batch_vertex_shader(void);
+const char* rgfx_internal_default_text_batch_fragment_shader(bool sdf);
+
+const rgfx_program_info_t* rgfx_internal_program_info(unsigned int program);
+int  rgfx_internal_program_uniform_location(const rgfx_program_info_t* info, const char* name);
+void rgfx_internal_program_reset_uniforms(const rgfx_program_info_t* info, const int* keep_locations, int keep_count);
+void rgfx_internal_program_mark_uniform(const rgfx_program_info_t* info, int location);
+void rgfx_internal_program_registry_shutdown(void);
+
+/* sprite may be NULL for a draw that sets no custom uniforms */
+void rgfx_internal_sprite_apply_uniforms(const rgfx_program_info_t* program, const rgfx_sprite_t* sprite);
 
 rgfx_camera_t* rgfx_internal_get_active_camera(void);
 void           rgfx_internal_set_active_camera(rgfx_camera_t* camera);
 
-unsigned int rgfx_internal_acquire_text_shader_program(void);
-void         rgfx_internal_release_text_shader_program(void);
+/* Matrices of the active camera (identity without one); revision changes whenever they do */
+typedef struct
+{
+    mat4x4   view;
+    mat4x4   projection;
+    mat4x4   view_projection;
+    uint32_t revision;
+} rgfx_camera_state_t;
+
+const rgfx_camera_state_t* rgfx_internal_camera_state(void);
+
+#define RGFX_FRAME_UNIFORM_BINDING    0
+#define RGFX_FRAME_UNIFORM_BLOCK_NAME "RasterFrame"
+
+/* std140 mirror of the RasterFrame uniform block */
+typedef struct
+{
+    float view[16];
+    float projection[16];
+    float view_projection[16];
+    float time;
+    float delta_time;
+    float viewport_size[2];
+} rgfx_frame_uniforms_t;
+
+void     rgfx_internal_frame_uniforms_sync(void);
+uint32_t rgfx_internal_frame_index(void);
+float    rgfx_internal_frame_time(void);
+
+void rgfx_internal_program_upload_frame(const rgfx_program_info_t* program);
+
+unsigned int rgfx_internal_acquire_shader_program(const char* vertexSource, const char* fragmentSource);
+void         rgfx_internal_release_shader_program(unsigned int program);
+
+void rgfx_internal_stats_count_draw(bool instanced);
+void rgfx_internal_stats_count_state_change(bool skipped);
+void rgfx_internal_stats_count_sprites(uint32_t sprites);
+void rgfx_internal_stats_count_texts(uint32_t texts);
+void rgfx_internal_stats_count_texture_bind(void);
+
+void rgfx_internal_batch_push_sprite(const rgfx_sprite_t* sprite);
+void rgfx_internal_batch_flush(void);
+void rgfx_internal_batch_shutdown(void);
+
+/* Texts drawn inside a batch are baked to world space and merged per atlas into one streamed draw */
+void rgfx_internal_text_batch_begin(void);
+void rgfx_internal_text_batch_end(void);
+bool rgfx_internal_text_batch_push(const rgfx_text_t* text);
+void rgfx_internal_text_batch_flush(void);
+void rgfx_internal_text_batch_shutdown(void);
+
+void rgfx_internal_queue_flush(void);
+void rgfx_internal_queue_shutdown(void);
+
+void rgfx_internal_texture_shutdown(void);
+
+typedef struct
+{
+    char*    name;
+    uint32_t name_hash;
+    uint32_t page;
+    bool     has_alpha;
+    int      width;
+    int      height;
+    float    uv_rect[4];
+} rgfx_atlas_region_t;
+
+typedef struct
+{
+    unsigned int*        pages;
+    uint32_t             page_count;
+    int                  page_size;
+    int                  max_level; /* deepest mip whose padding still separates regions */
+    rgfx_atlas_region_t* regions;
+    uint32_t             region_count;
+    uint32_t*            region_index;
+    uint32_t             region_index_mask;
+    size_t               pixels_used;
+    int                  refcount;
+} rgfx_atlas_t;
+
+void                       rgfx_internal_atlas_retain(rgfx_atlas_handle atlas);
+const rgfx_atlas_region_t* rgfx_internal_atlas_find_region(rgfx_atlas_handle atlas, const char* name, unsigned int* out_texture);
+void                       rgfx_internal_atlas_shutdown(void);
+
+rgfx_font_t*               rgfx_internal_font_acquire(const char* path);
+void                       rgfx_internal_font_release(rgfx_font_t* font);
+/* Async loading: load_detached only reads and parses, so it may run on a job worker; the main
+   thread then adopts the result (sharing an already loaded copy) or discards it. */
+rgfx_font_t*               rgfx_internal_font_load_detached(const char* path);
+rgfx_font_t*               rgfx_internal_font_adopt(rgfx_font_t* font);
+void                       rgfx_internal_font_discard(rgfx_font_t* font);
+rgfx_font_metrics_t*       rgfx_internal_font_metrics(rgfx_font_t* font, float pixel_height);
+int                        rgfx_internal_font_glyph_advance(rgfx_font_metrics_t* metrics, int codepoint);
+int                        rgfx_internal_font_glyph_kerning(rgfx_font_metrics_t* metrics, int left, int right);
+
+/* Layout lookups: ASCII advances and printable ASCII kerning pairs are plain array reads */
+static inline int rgfx_font_advance(rgfx_font_metrics_t* metrics, int codepoint)
+{
+    if ((unsigned)codepoint < RGFX_FONT_ASCII_COUNT)
+    {
+        return metrics->ascii_advance[codepoint];
+    }
+    return rgfx_internal_font_glyph_advance(metrics, codepoint);
+}
+
+static inline int rgfx_font_kerning(rgfx_font_metrics_t* metrics, int left, int right)
+{
+    if (!metrics->has_kerning)
+    {
+        return 0;
+    }
+
+    unsigned l = (unsigned)(left - RGFX_FONT_KERN_FIRST);
+    unsigned r = (unsigned)(right - RGFX_FONT_KERN_FIRST);
+    if (l < RGFX_FONT_KERN_COUNT && r < RGFX_FONT_KERN_COUNT)
+    {
+        return metrics->kerning[l * RGFX_FONT_KERN_COUNT + r];
+    }
+    return rgfx_internal_font_glyph_kerning(metrics, left, right);
+}
+
+rgfx_glyph_atlas_t* rgfx_internal_glyph_atlas_acquire(rgfx_font_t* font, float pixel_height, bool sdf);
+void                rgfx_internal_glyph_atlas_release(rgfx_glyph_atlas_t* atlas);
+const rgfx_glyph_t* rgfx_internal_glyph_atlas_get(rgfx_glyph_atlas_t* atlas, int codepoint);
+void                rgfx_internal_glyph_atlas_flush(rgfx_glyph_atlas_t* atlas);
+unsigned int        rgfx_internal_glyph_index_buffer(uint32_t quad_count);
+
+void rgfx_internal_font_shutdown(void);
+bool rgfx_internal_texture_has_alpha(rgfx_texture_handle texture);
+
+/* Decodes an image through the asset layer, flipped for GL's bottom-left origin */
+unsigned char* rgfx_internal_load_image(const char* filepath, int* out_width, int* out_height, int* out_channels, int desired_channels);
+void           rgfx_internal_free_image(unsigned char* pixels);
 
 rgfx_sprite_handle rgfx_internal_sprite_register(rgfx_sprite_t* sprite);
 void               rgfx_internal_sprite_unregister(rgfx_sprite_handle sprite);
 rgfx_sprite_t*     rgfx_internal_sprite_resolve(rgfx_sprite_handle sprite);
+bool               rgfx_internal_sprite_is_translucent(const rgfx_sprite_t* sprite);
 
 rgfx_text_handle rgfx_internal_text_register(rgfx_text_t* text);
 void             rgfx_internal_text_unregister(rgfx_text_handle text);
@@ -0,0 +1,158 @@
+#include "raster_gfx_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define RGFX_SKYLINE_INITIAL_NODES 16
+
+bool rgfx_internal_skyline_init(rgfx_skyline_t* skyline, int bin_width)
+{
+    skyline->nodes = (rgfx_skyline_node_t*)malloc(RGFX_SKYLINE_INITIAL_NODES * sizeof(rgfx_skyline_node_t));
+    if (!skyline->nodes)
+    {
+        skyline->count    = 0;
+        skyline->capacity = 0;
+        return false;
+    }
+
+    skyline->capacity       = RGFX_SKYLINE_INITIAL_NODES;
+    skyline->count          = 1;
+    skyline->nodes[0].x     = 0;
+    skyline->nodes[0].y     = 0;
+    skyline->nodes[0].width = bin_width;
+    return true;
+}
+
+void rgfx_internal_skyline_free(rgfx_skyline_t* skyline)
+{
+    free(skyline->nodes);
+    skyline->nodes    = NULL;
+    skyline->count    = 0;
+    skyline->capacity = 0;
+}
+
+/* Lowest y at which a rect of the given width fits when its left edge sits on skyline node index */
+static int rgfx_skyline_fit(const rgfx_skyline_t* skyline, int bin_width, int index, int width)
+{
+    int x = skyline->nodes[index].x;
+    if (x + width > bin_width)
+    {
+        return -1;
+    }
+
+    int y         = 0;
+    int remaining = width;
+    for (int i = index; remaining > 0; ++i)
+    {
+        if (skyline->nodes[i].y > y)
+        {
+            y = skyline->nodes[i].y;
+        }
+        remaining -= skyline->nodes[i].width;
+    }
+    return y;
+}
+
+static bool rgfx_skyline_insert(rgfx_skyline_t* skyline, int index, int x, int y, int width)
+{
+    if (skyline->count + 1 > skyline->capacity)
+    {
+        int                  new_capacity = skyline->capacity * 2;
+        rgfx_skyline_node_t* nodes =
+            (rgfx_skyline_node_t*)realloc(skyline->nodes, (size_t)new_capacity * sizeof(rgfx_skyline_node_t));
+        if (!nodes)
+        {
+            return false;
+        }
+        skyline->nodes    = nodes;
+        skyline->capacity = new_capacity;
+    }
+
+    memmove(&skyline->nodes[index + 1],
+            &skyline->nodes[index],
+            (size_t)(skyline->count - index) * sizeof(rgfx_skyline_node_t));
+    skyline->nodes[index].x     = x;
+    skyline->nodes[index].y     = y;
+    skyline->nodes[index].width = width;
+    skyline->count++;
+
+    // Trim or drop the nodes now covered by the new segment
+    for (int i = index + 1; i < skyline->count;)
+    {
+        rgfx_skyline_node_t* previous = &skyline->nodes[i - 1];
+        rgfx_skyline_node_t* node     = &skyline->nodes[i];
+        int                  overlap  = previous->x + previous->width - node->x;
+        if (overlap <= 0)
+        {
+            break;
+        }
+
+        node->x     += overlap;
+        node->width -= overlap;
+        if (node->width > 0)
+        {
+            break;
+        }
+
+        memmove(node, node + 1, (size_t)(skyline->count - i - 1) * sizeof(rgfx_skyline_node_t));
+        skyline->count--;
+    }
+
+    for (int i = 0; i < skyline->count - 1;)
+    {
+        if (skyline->nodes[i].y == skyline->nodes[i + 1].y)
+        {
+            skyline->nodes[i].width += skyline->nodes[i + 1].width;
+            memmove(&skyline->nodes[i + 1],
+                    &skyline->nodes[i + 2],
+                    (size_t)(skyline->count - i - 2) * sizeof(rgfx_skyline_node_t));
+            skyline->count--;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return true;
+}
+
+/* Bottom-left skyline packing: place the rect where its top ends lowest, preferring the narrower gap */
+bool rgfx_internal_skyline_pack(rgfx_skyline_t* skyline, int bin_width, int bin_height, int width, int height, int* out_x, int* out_y)
+{
+    int best_index = -1;
+    int best_y     = 0;
+    int best_width = 0;
+
+    for (int i = 0; i < skyline->count; ++i)
+    {
+        int y = rgfx_skyline_fit(skyline, bin_width, i, width);
+        if (y < 0 || y + height > bin_height)
+        {
+            continue;
+        }
+
+        if (best_index < 0 || y < best_y ||
+            (y == best_y && skyline->nodes[i].width < best_width))
+        {
+            best_index = i;
+            best_y     = y;
+            best_width = skyline->nodes[i].width;
+        }
+    }
+
+    if (best_index < 0)
+    {
+        return false;
+    }
+
+    int x = skyline->nodes[best_index].x;
+    if (!rgfx_skyline_insert(skyline, best_index, x, best_y + height, width))
+    {
+        return false;
+    }
+
+    *out_x = x;
+    *out_y = best_y;
+    return true;
+}
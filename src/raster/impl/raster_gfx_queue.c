@@ -0,0 +1,282 @@
+#include "raster_gfx_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define RGFX_QUEUE_INITIAL_CAPACITY 256u
+
+/*
+    Sort key layout, most significant bits first:
+
+      63..56  layer
+      55      translucent
+      opaque:       54..39 program | 38..23 texture | 22..0 depth, front to back
+      translucent:  54..23 depth, back to front | 22..12 program | 11..0 texture
+
+    The radix sort is stable, so draws with equal keys keep their submission order.
+*/
+#define RGFX_KEY_LAYER_SHIFT       56u
+#define RGFX_KEY_TRANSLUCENT_SHIFT 55u
+#define RGFX_KEY_GROUP_SHIFT       55u
+
+typedef enum
+{
+    RGFX_QUEUE_SPRITE,
+    RGFX_QUEUE_TEXT,
+} rgfx_queue_kind_t;
+
+typedef struct
+{
+    uint64_t key;
+    uint32_t handle;
+    uint32_t kind;
+} rgfx_queue_item_t;
+
+static struct
+{
+    rgfx_queue_item_t* items;
+    rgfx_queue_item_t* scratch;
+    uint32_t           count;
+    uint32_t           capacity;
+} g_queue = { 0 };
+
+static bool rgfx_queue_reserve(uint32_t count)
+{
+    if (count <= g_queue.capacity)
+    {
+        return true;
+    }
+
+    uint32_t new_capacity = g_queue.capacity ? g_queue.capacity : RGFX_QUEUE_INITIAL_CAPACITY;
+    while (new_capacity < count)
+    {
+        new_capacity *= 2u;
+    }
+
+    rgfx_queue_item_t* items =
+        (rgfx_queue_item_t*)realloc(g_queue.items, (size_t)new_capacity * sizeof(rgfx_queue_item_t));
+    if (!items)
+    {
+        return false;
+    }
+    g_queue.items = items;
+
+    rgfx_queue_item_t* scratch =
+        (rgfx_queue_item_t*)realloc(g_queue.scratch, (size_t)new_capacity * sizeof(rgfx_queue_item_t));
+    if (!scratch)
+    {
+        return false;
+    }
+    g_queue.scratch = scratch;
+
+    g_queue.capacity = new_capacity;
+    return true;
+}
+
+/* Maps a float onto a uint32_t whose unsigned order matches the float order */
+static inline uint32_t rgfx_float_sort_bits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+static float rgfx_queue_view_depth(rtransform_t* transform)
+{
+    vec3 position;
+    rtransform_get_world_position(transform, position);
+
+    const rgfx_camera_state_t* camera = rgfx_internal_camera_state();
+    vec4 world = { position[0], position[1], position[2], 1.0f };
+    vec4 view;
+    mat4x4_mul_vec4_simd(view, camera->view, world);
+
+    // The camera looks down -Z, so distance grows as view-space z decreases
+    return -view[2];
+}
+
+static uint64_t rgfx_queue_make_key(uint8_t layer, bool translucent, unsigned int program, unsigned int texture, float depth)
+{
+    uint64_t key        = (uint64_t)layer << RGFX_KEY_LAYER_SHIFT;
+    uint32_t depth_bits = rgfx_float_sort_bits(depth);
+
+    if (translucent)
+    {
+        key |= 1ull << RGFX_KEY_TRANSLUCENT_SHIFT;
+        key |= (uint64_t)(~depth_bits) << 23u;
+        key |= (uint64_t)(program & 0x7FFu) << 12u;
+        key |= (uint64_t)(texture & 0xFFFu);
+    }
+    else
+    {
+        key |= (uint64_t)(program & 0xFFFFu) << 39u;
+        key |= (uint64_t)(texture & 0xFFFFu) << 23u;
+        key |= (uint64_t)(depth_bits >> 9u);
+    }
+
+    return key;
+}
+
+static void rgfx_queue_push(uint64_t key, uint32_t handle, rgfx_queue_kind_t kind)
+{
+    if (!rgfx_queue_reserve(g_queue.count + 1u))
+    {
+        rlog_error("rgfx: failed to grow render queue");
+        return;
+    }
+
+    rgfx_queue_item_t* item = &g_queue.items[g_queue.count++];
+    item->key               = key;
+    item->handle            = handle;
+    item->kind              = (uint32_t)kind;
+}
+
+/* LSD radix sort on the 64-bit keys, 8 bits per pass; passes where every key shares the byte are skipped */
+static void rgfx_queue_sort(void)
+{
+    uint32_t           count = g_queue.count;
+    rgfx_queue_item_t* src   = g_queue.items;
+    rgfx_queue_item_t* dst   = g_queue.scratch;
+
+    for (uint32_t shift = 0; shift < 64u; shift += 8u)
+    {
+        uint32_t histogram[256] = { 0 };
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            histogram[(src[i].key >> shift) & 0xFFu]++;
+        }
+
+        if (histogram[(src[0].key >> shift) & 0xFFu] == count)
+        {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (uint32_t bucket = 0; bucket < 256u; ++bucket)
+        {
+            uint32_t bucket_count = histogram[bucket];
+            histogram[bucket]     = offset;
+            offset               += bucket_count;
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            dst[histogram[(src[i].key >> shift) & 0xFFu]++] = src[i];
+        }
+
+        rgfx_queue_item_t* swap = src;
+        src                     = dst;
+        dst                     = swap;
+    }
+
+    g_queue.items   = src;
+    g_queue.scratch = dst;
+}
+
+void rgfx_sprite_submit(rgfx_sprite_handle sprite, uint8_t layer)
+{
+    rgfx_sprite_t* sprite_ptr = rgfx_internal_sprite_resolve(sprite);
+    if (!sprite_ptr || !sprite_ptr->transform)
+    {
+        return;
+    }
+
+    float    depth = rgfx_queue_view_depth(sprite_ptr->transform);
+    uint64_t key   = rgfx_queue_make_key(layer,
+                                       rgfx_internal_sprite_is_translucent(sprite_ptr),
+                                       sprite_ptr->shaderProgram,
+                                       sprite_ptr->hasTexture ? sprite_ptr->textureID : 0,
+                                       depth);
+    rgfx_queue_push(key, sprite, RGFX_QUEUE_SPRITE);
+}
+
+void rgfx_text_submit(rgfx_text_handle text, uint8_t layer)
+{
+    rgfx_text_t* text_ptr = rgfx_internal_text_resolve(text);
+    if (!text_ptr || !text_ptr->transform || !text_ptr->atlas)
+    {
+        return;
+    }
+
+    // Glyph coverage is alpha blended, so text always sorts with the translucent draws
+    float    depth = rgfx_queue_view_depth(text_ptr->transform);
+    uint64_t key   = rgfx_queue_make_key(layer, true, text_ptr->shaderProgram, text_ptr->atlas->texture, depth);
+    rgfx_queue_push(key, text, RGFX_QUEUE_TEXT);
+}
+
+static void rgfx_queue_flush_batches(void)
+{
+    rgfx_internal_batch_flush();
+    rgfx_internal_text_batch_flush();
+}
+
+void rgfx_internal_queue_flush(void)
+{
+    if (g_queue.count == 0)
+    {
+        return;
+    }
+
+    rgfx_queue_sort();
+
+    rgfx_batch_begin();
+
+    uint64_t     group        = 0;
+    bool         has_group    = false;
+    unsigned int last_program = 0;
+    unsigned int last_texture = 0;
+
+    for (uint32_t i = 0; i < g_queue.count; ++i)
+    {
+        const rgfx_queue_item_t* item = &g_queue.items[i];
+
+        // Layers and the opaque/translucent split must not be reordered by the batch
+        uint64_t item_group = item->key >> RGFX_KEY_GROUP_SHIFT;
+        if (has_group && item_group != group)
+        {
+            rgfx_queue_flush_batches();
+        }
+        group     = item_group;
+        has_group = true;
+
+        bool translucent = (item->key >> RGFX_KEY_TRANSLUCENT_SHIFT) & 1u;
+
+        // Texts merge into the text batch, which flushes pending sprites itself
+        if (item->kind == RGFX_QUEUE_TEXT)
+        {
+            rgfx_text_draw(item->handle);
+            continue;
+        }
+
+        rgfx_sprite_t* sprite = rgfx_internal_sprite_resolve(item->handle);
+        if (!sprite)
+        {
+            continue;
+        }
+
+        unsigned int texture = sprite->hasTexture ? sprite->textureID : 0;
+
+        // Non-instanced sprites draw immediately, and translucent ones must reach the screen in key order,
+        // so close the pending batch whenever it would otherwise be reordered around this draw
+        if (!sprite->program_info->instanced ||
+            (translucent && (sprite->shaderProgram != last_program || texture != last_texture || sprite->uniform_count > 0)))
+        {
+            rgfx_queue_flush_batches();
+        }
+        last_program = sprite->shaderProgram;
+        last_texture = texture;
+
+        rgfx_sprite_draw(item->handle);
+    }
+
+    rgfx_batch_end();
+
+    g_queue.count = 0;
+}
+
+void rgfx_internal_queue_shutdown(void)
+{
+    free(g_queue.items);
+    free(g_queue.scratch);
+    memset(&g_queue, 0, sizeof(g_queue));
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+/*
+    .rtex - cooked texture container written by tools/texture_cook and read by rgfx texture loading
+
+    A fixed little-endian header followed by the full mip chain, level 0 first. Pixels are
+    already flipped for GL's bottom-left origin, rows are padded to row_alignment bytes so
+    each level can go straight to glTexImage2D with GL_UNPACK_ALIGNMENT set to match, and
+    every level starts on an RGFX_RTEX_LEVEL_ALIGNMENT boundary.
+*/
+
+#include <stdint.h>
+
+#define RGFX_RTEX_MAGIC           0x58455452u /* "RTEX" */
+#define RGFX_RTEX_VERSION         1u
+#define RGFX_RTEX_MAX_LEVELS      16u
+#define RGFX_RTEX_LEVEL_ALIGNMENT 16u
+#define RGFX_RTEX_EXTENSION       ".rtex"
+
+#define RGFX_RTEX_FLAG_FLIPPED 1u /* rows stored bottom to top */
+
+typedef struct
+{
+    uint32_t offset; /* from the start of the file */
+    uint32_t size;   /* row-padded bytes */
+} rgfx_rtex_level_t;
+
+typedef struct
+{
+    uint32_t          magic;
+    uint32_t          version;
+    uint32_t          width;
+    uint32_t          height;
+    uint32_t          channels; /* 1, 3 or 4 */
+    uint32_t          level_count;
+    uint32_t          row_alignment; /* 1 or 4 */
+    uint32_t          flags;
+    rgfx_rtex_level_t levels[RGFX_RTEX_MAX_LEVELS];
+} rgfx_rtex_header_t;
+
+static inline uint32_t rgfx_rtex_level_dimension(uint32_t base, uint32_t level)
+{
+    base >>= level;
+    return base ? base : 1u;
+}
+
+/* Levels in a complete chain down to 1x1: floor(log2(max(width, height))) + 1 */
+static inline uint32_t rgfx_rtex_full_level_count(uint32_t width, uint32_t height)
+{
+    uint32_t size  = width > height ? width : height;
+    uint32_t count = 1u;
+    while (size > 1u)
+    {
+        size >>= 1u;
+        count++;
+    }
+    return count;
+}
+
+static inline uint32_t rgfx_rtex_row_pitch(uint32_t width, uint32_t channels, uint32_t row_alignment)
+{
+    uint32_t row = width * channels;
+    return (row + row_alignment - 1u) & ~(row_alignment - 1u);
+}
@@ -0,0 +1,715 @@
+#include "raster_gfx_internal.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define RGFX_PROGRAM_TABLE_INITIAL_CAPACITY 64u
+
+static const char* const k_uniform_slot_names[RGFX_UNIFORM_SLOT_COUNT] = {
+    "uModel", "uView", "uProjection", "uColor", "uTime", "uSize", "uUseTexture", "uTexture", "uUVRect",
+};
+
+static struct
+{
+    rgfx_program_info_t** entries;
+    uint32_t              capacity;
+    uint32_t              count;
+} g_programs = { 0 };
+
+/* Programs shared between objects created from identical sources, looked up by source hash and
+   confirmed against the stored sources so a hash collision never hands out the wrong program */
+static struct
+{
+    rgfx_program_info_t** entries;
+    uint32_t              count;
+    uint32_t              capacity;
+} g_program_cache = { 0 };
+
+static uint64_t rgfx_hash_bytes(uint64_t hash, const char* data, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint64_t rgfx_hash_program_sources(const char* vertexSource, const char* fragmentSource)
+{
+    uint64_t hash = 14695981039346656037ull;
+    hash          = rgfx_hash_bytes(hash, vertexSource, strlen(vertexSource) + 1);
+    hash          = rgfx_hash_bytes(hash, fragmentSource, strlen(fragmentSource) + 1);
+    return hash;
+}
+
+static uint32_t rgfx_hash_string(const char* str)
+{
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)str; *p; ++p)
+    {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static inline uint32_t rgfx_program_bucket(unsigned int program, uint32_t capacity)
+{
+    return ((uint32_t)program * 2654435761u) & (capacity - 1u);
+}
+
+static void rgfx_program_info_free(rgfx_program_info_t* info)
+{
+    if (!info)
+    {
+        return;
+    }
+
+    for (int i = 0; i < info->uniform_count; ++i)
+    {
+        free(info->uniforms[i].name);
+    }
+    free(info->uniforms);
+    free(info->sources);
+    free(info);
+}
+
+static void rgfx_program_table_insert(rgfx_program_info_t* info)
+{
+    uint32_t mask  = g_programs.capacity - 1u;
+    uint32_t index = rgfx_program_bucket(info->program, g_programs.capacity);
+    while (g_programs.entries[index])
+    {
+        index = (index + 1u) & mask;
+    }
+    g_programs.entries[index] = info;
+    g_programs.count++;
+}
+
+static bool rgfx_program_table_reserve(uint32_t count)
+{
+    // Keep the load factor at or below one half so probe chains stay short
+    if (g_programs.capacity && count * 2u <= g_programs.capacity)
+    {
+        return true;
+    }
+
+    uint32_t new_capacity = g_programs.capacity ? g_programs.capacity * 2u : RGFX_PROGRAM_TABLE_INITIAL_CAPACITY;
+    while (count * 2u > new_capacity)
+    {
+        new_capacity *= 2u;
+    }
+
+    rgfx_program_info_t** old_entries  = g_programs.entries;
+    uint32_t              old_capacity = g_programs.capacity;
+
+    g_programs.entries = (rgfx_program_info_t**)calloc(new_capacity, sizeof(rgfx_program_info_t*));
+    if (!g_programs.entries)
+    {
+        g_programs.entries = old_entries;
+        return false;
+    }
+
+    g_programs.capacity = new_capacity;
+    g_programs.count    = 0;
+    for (uint32_t i = 0; i < old_capacity; ++i)
+    {
+        if (old_entries[i])
+        {
+            rgfx_program_table_insert(old_entries[i]);
+        }
+    }
+
+    free(old_entries);
+    return true;
+}
+
+static uint32_t rgfx_program_table_find(unsigned int program)
+{
+    if (!g_programs.capacity || program == 0)
+    {
+        return UINT32_MAX;
+    }
+
+    uint32_t mask  = g_programs.capacity - 1u;
+    uint32_t index = rgfx_program_bucket(program, g_programs.capacity);
+    while (g_programs.entries[index])
+    {
+        if (g_programs.entries[index]->program == program)
+        {
+            return index;
+        }
+        index = (index + 1u) & mask;
+    }
+    return UINT32_MAX;
+}
+
+static void rgfx_program_table_remove(uint32_t index)
+{
+    uint32_t mask = g_programs.capacity - 1u;
+
+    g_programs.entries[index] = NULL;
+    g_programs.count--;
+
+    // Re-seat the rest of the probe chain so later lookups do not stop at the hole
+    for (uint32_t next = (index + 1u) & mask; g_programs.entries[next]; next = (next + 1u) & mask)
+    {
+        rgfx_program_info_t* displaced = g_programs.entries[next];
+        g_programs.entries[next]       = NULL;
+        g_programs.count--;
+        rgfx_program_table_insert(displaced);
+    }
+}
+
+static rgfx_program_info_t* rgfx_program_reflect(unsigned int program)
+{
+    rgfx_program_info_t* info = (rgfx_program_info_t*)calloc(1, sizeof(rgfx_program_info_t));
+    if (!info)
+    {
+        return NULL;
+    }
+
+    info->program = program;
+
+    GLint active_uniforms = 0;
+    GLint max_name_length = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &active_uniforms);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length);
+
+    char* name = NULL;
+    if (active_uniforms > 0 && max_name_length > 0)
+    {
+        info->uniforms = (rgfx_program_uniform_t*)calloc((size_t)active_uniforms, sizeof(rgfx_program_uniform_t));
+        name           = (char*)malloc((size_t)max_name_length + 1);
+        if (!info->uniforms || !name)
+        {
+            free(name);
+            rgfx_program_info_free(info);
+            return NULL;
+        }
+    }
+
+    for (GLint i = 0; i < active_uniforms && name; ++i)
+    {
+        GLsizei length = 0;
+        GLint   size   = 0;
+        GLenum  type   = 0;
+        glGetActiveUniform(program, (GLuint)i, max_name_length, &length, &size, &type, name);
+        name[length] = '\0';
+
+        // Arrays are reported as "name[0]"; look them up by their base name
+        char* bracket = strchr(name, '[');
+        if (bracket)
+        {
+            *bracket = '\0';
+        }
+
+        // Members of uniform blocks have no location and are skipped
+        int location = glGetUniformLocation(program, name);
+        if (location == -1)
+        {
+            continue;
+        }
+
+        rgfx_program_uniform_t* uniform = &info->uniforms[info->uniform_count];
+        uniform->name = (char*)malloc(strlen(name) + 1);
+        if (!uniform->name)
+        {
+            continue;
+        }
+        strcpy(uniform->name, name);
+        uniform->hash     = rgfx_hash_string(name);
+        uniform->location = location;
+        uniform->type     = type;
+        uniform->applied  = false;
+        info->uniform_count++;
+    }
+    free(name);
+
+    for (int slot = 0; slot < RGFX_UNIFORM_SLOT_COUNT; ++slot)
+    {
+        info->slots[slot] = rgfx_internal_program_uniform_location(info, k_uniform_slot_names[slot]);
+    }
+
+    info->instanced = glGetAttribLocation(program, "aInstanceModel") != -1;
+
+    GLuint frame_block = glGetUniformBlockIndex(program, RGFX_FRAME_UNIFORM_BLOCK_NAME);
+    if (frame_block != GL_INVALID_INDEX)
+    {
+        glUniformBlockBinding(program, frame_block, RGFX_FRAME_UNIFORM_BINDING);
+        info->frame_block = true;
+    }
+
+    return info;
+}
+
+static bool rgfx_program_register(unsigned int program)
+{
+    if (!rgfx_program_table_reserve(g_programs.count + 1u))
+    {
+        return false;
+    }
+
+    rgfx_program_info_t* info = rgfx_program_reflect(program);
+    if (!info)
+    {
+        return false;
+    }
+
+    rgfx_program_table_insert(info);
+    return true;
+}
+
+const rgfx_program_info_t* rgfx_internal_program_info(unsigned int program)
+{
+    uint32_t index = rgfx_program_table_find(program);
+    return index == UINT32_MAX ? NULL : g_programs.entries[index];
+}
+
+void rgfx_internal_program_upload_frame(const rgfx_program_info_t* program)
+{
+    if (!program)
+    {
+        return;
+    }
+
+    // Callers hold the info read-only; the upload bookkeeping below is the one thing drawing updates
+    rgfx_program_info_t* info = (rgfx_program_info_t*)program;
+    if (info->frame_block)
+    {
+        rgfx_internal_frame_uniforms_sync();
+        return;
+    }
+
+    // Uniform values live in the program object, so only re-upload what changed since its last draw
+    const rgfx_camera_state_t* camera = rgfx_internal_camera_state();
+    if (info->camera_revision != camera->revision)
+    {
+        glUniformMatrix4fv(info->slots[RGFX_UNIFORM_SLOT_VIEW], 1, GL_FALSE, (const float*)camera->view);
+        glUniformMatrix4fv(info->slots[RGFX_UNIFORM_SLOT_PROJECTION], 1, GL_FALSE, (const float*)camera->projection);
+        info->camera_revision = camera->revision;
+    }
+
+    uint32_t frame_index = rgfx_internal_frame_index();
+    if (info->frame_index != frame_index)
+    {
+        glUniform1f(info->slots[RGFX_UNIFORM_SLOT_TIME], rgfx_internal_frame_time());
+        info->frame_index = frame_index;
+    }
+}
+
+int rgfx_internal_program_uniform_location(const rgfx_program_info_t* info, const char* name)
+{
+    if (!info || !name)
+    {
+        return -1;
+    }
+
+    uint32_t hash = rgfx_hash_string(name);
+    for (int i = 0; i < info->uniform_count; ++i)
+    {
+        if (info->uniforms[i].hash == hash && strcmp(info->uniforms[i].name, name) == 0)
+        {
+            return info->uniforms[i].location;
+        }
+    }
+    return -1;
+}
+
+static bool rgfx_program_is_slot(const rgfx_program_info_t* info, int location)
+{
+    for (int slot = 0; slot < RGFX_UNIFORM_SLOT_COUNT; ++slot)
+    {
+        if (info->slots[slot] == location)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void rgfx_program_zero_uniform(const rgfx_program_uniform_t* uniform)
+{
+    switch (uniform->type)
+    {
+    case GL_FLOAT:
+        glUniform1f(uniform->location, 0.0f);
+        break;
+    case GL_FLOAT_VEC2:
+        glUniform2f(uniform->location, 0.0f, 0.0f);
+        break;
+    case GL_FLOAT_VEC3:
+        glUniform3f(uniform->location, 0.0f, 0.0f, 0.0f);
+        break;
+    case GL_FLOAT_VEC4:
+        glUniform4f(uniform->location, 0.0f, 0.0f, 0.0f, 0.0f);
+        break;
+    case GL_INT:
+    case GL_BOOL:
+        glUniform1i(uniform->location, 0);
+        break;
+    default:
+        // Sprites only set float, int and vector uniforms
+        break;
+    }
+}
+
+/*
+    Programs are shared between sprites, and uniform values live in the program, so a custom
+    uniform one sprite set would leak into the next draw. Every applied uniform not in keep
+    goes back to the zero it had after linking. Call with the program in use.
+*/
+void rgfx_internal_program_reset_uniforms(const rgfx_program_info_t* info, const int* keep_locations, int keep_count)
+{
+    if (!info || info->applied_count == 0)
+    {
+        return;
+    }
+
+    rgfx_program_info_t* program = (rgfx_program_info_t*)info;
+    for (int i = 0; i < program->uniform_count && program->applied_count > 0; ++i)
+    {
+        rgfx_program_uniform_t* uniform = &program->uniforms[i];
+        if (!uniform->applied)
+        {
+            continue;
+        }
+
+        bool keep = false;
+        for (int k = 0; k < keep_count && !keep; ++k)
+        {
+            keep = keep_locations[k] == uniform->location;
+        }
+        if (keep)
+        {
+            continue;
+        }
+
+        rgfx_program_zero_uniform(uniform);
+        uniform->applied = false;
+        program->applied_count--;
+    }
+}
+
+/* Records that a sprite's value now sits in this uniform; engine slots are rewritten every draw */
+void rgfx_internal_program_mark_uniform(const rgfx_program_info_t* info, int location)
+{
+    if (!info || location == -1 || rgfx_program_is_slot(info, location))
+    {
+        return;
+    }
+
+    rgfx_program_info_t* program = (rgfx_program_info_t*)info;
+    for (int i = 0; i < program->uniform_count; ++i)
+    {
+        rgfx_program_uniform_t* uniform = &program->uniforms[i];
+        if (uniform->location == location)
+        {
+            if (!uniform->applied)
+            {
+                uniform->applied = true;
+                program->applied_count++;
+            }
+            return;
+        }
+    }
+}
+
+unsigned int rgfx_internal_acquire_shader_program(const char* vertexSource, const char* fragmentSource)
+{
+    if (!vertexSource || !fragmentSource)
+    {
+        return 0;
+    }
+
+    const size_t vertex_size   = strlen(vertexSource) + 1;
+    const size_t fragment_size = strlen(fragmentSource) + 1;
+    const size_t sources_size  = vertex_size + fragment_size;
+
+    uint64_t hash = rgfx_hash_program_sources(vertexSource, fragmentSource);
+    for (uint32_t i = 0; i < g_program_cache.count; ++i)
+    {
+        rgfx_program_info_t* cached = g_program_cache.entries[i];
+        if (cached->source_hash == hash && cached->sources_size == sources_size &&
+            memcmp(cached->sources, vertexSource, vertex_size) == 0 &&
+            memcmp(cached->sources + vertex_size, fragmentSource, fragment_size) == 0)
+        {
+            cached->refcount++;
+            return cached->program;
+        }
+    }
+
+    if (g_program_cache.count == g_program_cache.capacity)
+    {
+        uint32_t              new_capacity = g_program_cache.capacity ? g_program_cache.capacity * 2u : 16u;
+        rgfx_program_info_t** entries      = (rgfx_program_info_t**)realloc(
+            g_program_cache.entries, (size_t)new_capacity * sizeof(rgfx_program_info_t*));
+        if (!entries)
+        {
+            return 0;
+        }
+        g_program_cache.entries  = entries;
+        g_program_cache.capacity = new_capacity;
+    }
+
+    char* sources = (char*)malloc(sources_size);
+    if (!sources)
+    {
+        return 0;
+    }
+    memcpy(sources, vertexSource, vertex_size);
+    memcpy(sources + vertex_size, fragmentSource, fragment_size);
+
+    unsigned int program = rgfx_create_shader_program(vertexSource, fragmentSource);
+    if (!program)
+    {
+        free(sources);
+        return 0;
+    }
+
+    rgfx_program_info_t* info = (rgfx_program_info_t*)rgfx_internal_program_info(program);
+    info->source_hash         = hash;
+    info->sources             = sources;
+    info->sources_size        = sources_size;
+    info->refcount            = 1;
+    g_program_cache.entries[g_program_cache.count++] = info;
+
+    return program;
+}
+
+void rgfx_internal_release_shader_program(unsigned int program)
+{
+    for (uint32_t i = 0; i < g_program_cache.count; ++i)
+    {
+        rgfx_program_info_t* cached = g_program_cache.entries[i];
+        if (cached->program != program)
+        {
+            continue;
+        }
+
+        if (--cached->refcount > 0)
+        {
+            return;
+        }
+
+        g_program_cache.entries[i] = g_program_cache.entries[--g_program_cache.count];
+        rgfx_delete_shader_program(program);
+        return;
+    }
+
+    // Not cache-owned (e.g. created directly through rgfx_create_shader_program)
+    rgfx_delete_shader_program(program);
+}
+
+void rgfx_internal_program_registry_shutdown(void)
+{
+    for (uint32_t i = 0; i < g_program_cache.count; ++i)
+    {
+        rgfx_internal_state_forget_program(g_program_cache.entries[i]->program);
+        glDeleteProgram(g_program_cache.entries[i]->program);
+    }
+    free(g_program_cache.entries);
+    memset(&g_program_cache, 0, sizeof(g_program_cache));
+
+    for (uint32_t i = 0; i < g_programs.capacity; ++i)
+    {
+        rgfx_program_info_free(g_programs.entries[i]);
+    }
+    free(g_programs.entries);
+    memset(&g_programs, 0, sizeof(g_programs));
+}
+
+static const char* rgfx_shader_version_directive(void)
+{
+#if defined(__EMSCRIPTEN__)
+    return "#version 300 es\nprecision mediump float;\n";
+#else
+    return "#version 330 core\n";
+#endif
+}
+
+static unsigned int rgfx_compile_shader(unsigned int type, const char* source)
+{
+    unsigned int shader = glCreateShader(type);
+
+    // Sources read in place from an asset view may lack a directive; prepend it without copying
+    if (strstr(source, "#version") == NULL)
+    {
+        const char* sources[2] = { rgfx_shader_version_directive(), source };
+        glShaderSource(shader, 2, sources, NULL);
+    }
+    else
+    {
+        glShaderSource(shader, 1, &source, NULL);
+    }
+    glCompileShader(shader);
+
+    int success = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        char infoLog[512];
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        rlog_error("ERROR: Shader compilation failed\n%s\n", infoLog);
+        glDeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+
+unsigned int rgfx_create_shader_program(const char* vertexSource, const char* fragmentSource)
+{
+    if (!vertexSource || !fragmentSource)
+    {
+        return 0;
+    }
+
+    unsigned int vertexShader   = rgfx_compile_shader(GL_VERTEX_SHADER, vertexSource);
+    unsigned int fragmentShader = vertexShader ? rgfx_compile_shader(GL_FRAGMENT_SHADER, fragmentSource) : 0;
+
+    if (!vertexShader || !fragmentShader)
+    {
+        if (vertexShader)
+        {
+            glDeleteShader(vertexShader);
+        }
+        if (fragmentShader)
+        {
+            glDeleteShader(fragmentShader);
+        }
+        return 0;
+    }
+
+    unsigned int shaderProgram = glCreateProgram();
+    glAttachShader(shaderProgram, vertexShader);
+    glAttachShader(shaderProgram, fragmentShader);
+
+    // Shaders without explicit layout qualifiers still get the engine's attribute slots
+    glBindAttribLocation(shaderProgram, RGFX_ATTRIB_POSITION, "aPos");
+    glBindAttribLocation(shaderProgram, RGFX_ATTRIB_TEXCOORD, "aTexCoord");
+    glBindAttribLocation(shaderProgram, RGFX_ATTRIB_INSTANCE_MODEL, "aInstanceModel");
+    glBindAttribLocation(shaderProgram, RGFX_ATTRIB_INSTANCE_COLOR, "aInstanceColor");
+    glBindAttribLocation(shaderProgram, RGFX_ATTRIB_INSTANCE_SIZE, "aInstanceSize");
+    glBindAttribLocation(shaderProgram, RGFX_ATTRIB_VERTEX_COLOR, "aColor");
+    glBindAttribLocation(shaderProgram, RGFX_ATTRIB_INSTANCE_UV, "aInstanceUVRect");
+
+    glLinkProgram(shaderProgram);
+
+    int success = 0;
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        char infoLog[512];
+        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
+        rlog_error("Shader program linking failed\n%s\n", infoLog);
+        glDeleteProgram(shaderProgram);
+        shaderProgram = 0;
+    }
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    if (shaderProgram && !rgfx_program_register(shaderProgram))
+    {
+        rlog_error("Failed to build uniform table for shader program %u\n", shaderProgram);
+        glDeleteProgram(shaderProgram);
+        shaderProgram = 0;
+    }
+
+    return shaderProgram;
+}
+
+void rgfx_delete_shader_program(unsigned int program)
+{
+    if (!program)
+    {
+        return;
+    }
+
+    uint32_t index = rgfx_program_table_find(program);
+    if (index != UINT32_MAX)
+    {
+        rgfx_program_info_t* info = g_programs.entries[index];
+        rgfx_program_table_remove(index);
+        rgfx_program_info_free(info);
+    }
+
+    rgfx_internal_state_forget_program(program);
+    glDeleteProgram(program);
+}
+
+char* rgfx_load_shader_source(const char* filepath)
+{
+    if (!filepath)
+    {
+        return NULL;
+    }
+
+    rasset_view_t view;
+    if (!rasset_open(filepath, &view))
+    {
+        rlog_error("Failed to open shader file: %s\n", filepath);
+        return NULL;
+    }
+
+    // A loose file's view is already a private NUL-terminated copy; only pack views need one
+    size_t size   = view.size;
+    char*  source = (char*)view.owned;
+    if (!source)
+    {
+        source = (char*)malloc(size + 1);
+        if (!source)
+        {
+            rlog_error("Failed to allocate memory for shader source\n");
+            return NULL;
+        }
+        memcpy(source, view.data, size + 1);
+    }
+
+    if (strstr(source, "#version") == NULL)
+    {
+        const char* version_directive = rgfx_shader_version_directive();
+#if defined(__EMSCRIPTEN__)
+        rlog_info("Using WebGL/GLSL ES shader version for file: %s", filepath);
+#else
+        rlog_info("Using Desktop/GLSL shader version for file: %s", filepath);
+#endif
+        size_t directive_len = strlen(version_directive);
+        char*  new_source    = (char*)malloc(directive_len + size + 1);
+        if (!new_source)
+        {
+            free(source);
+            rlog_error("Failed to allocate memory for shader source with version directive\n");
+            return NULL;
+        }
+
+        strcpy(new_source, version_directive);
+        strcat(new_source, source);
+        free(source);
+        source = new_source;
+    }
+    else
+    {
+        char        versionLine[64] = { 0 };
+        const char* versionStart    = strstr(source, "#version");
+        if (versionStart)
+        {
+            const char* lineEnd = strchr(versionStart, '\n');
+            if (lineEnd)
+            {
+                size_t len = (size_t)(lineEnd - versionStart);
+                if (len < sizeof(versionLine) - 1)
+                {
+                    strncpy(versionLine, versionStart, len);
+                    versionLine[len] = '\0';
+                    rlog_info("Found existing version directive in %s: %s", filepath, versionLine);
+                }
+            }
+        }
+    }
+
+    return source;
+}
@@ -3,6 +3,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#define RGFX_SPRITE_BULK_CHUNK 256u
+
 static void rgfx_sprite_release_resources(rgfx_sprite_t* sprite)
 {
     if (!sprite)
@@ -10,35 +12,25 @@ static void rgfx_sprite_release_resources(rgfx_sprite_t* sprite)
         return;
     }
 
-    if (sprite->hasTexture && sprite->textureID)
+    if (sprite->texture != RGFX_INVALID_TEXTURE_HANDLE)
     {
-        glDeleteTextures(1, &sprite->textureID);
-        sprite->textureID = 0;
-        sprite->hasTexture = false;
+        rgfx_texture_release(sprite->texture);
+        sprite->texture = RGFX_INVALID_TEXTURE_HANDLE;
     }
+    sprite->textureID  = 0;
+    sprite->hasTexture = false;
 
     if (sprite->shaderProgram)
     {
-        glDeleteProgram(sprite->shaderProgram);
+        rgfx_internal_release_shader_program(sprite->shaderProgram);
         sprite->shaderProgram = 0;
+        sprite->program_info  = NULL;
     }
 
-    if (sprite->VAO)
-    {
-        glDeleteVertexArrays(1, &sprite->VAO);
-        sprite->VAO = 0;
-    }
-
-    if (sprite->VBO)
+    if (sprite->atlas != RGFX_INVALID_ATLAS_HANDLE)
     {
-        glDeleteBuffers(1, &sprite->VBO);
-        sprite->VBO = 0;
-    }
-
-    if (sprite->EBO)
-    {
-        glDeleteBuffers(1, &sprite->EBO);
-        sprite->EBO = 0;
+        rgfx_atlas_release(sprite->atlas);
+        sprite->atlas = RGFX_INVALID_ATLAS_HANDLE;
     }
 
     if (sprite->transform)
@@ -53,7 +45,17 @@ static rgfx_sprite_t* rgfx_sprite_from_handle(rgfx_sprite_handle handle)
     return rgfx_internal_sprite_resolve(handle);
 }
 
-rgfx_sprite_handle rgfx_sprite_create(const rgfx_sprite_desc_t* desc)
+bool rgfx_internal_sprite_is_translucent(const rgfx_sprite_t* sprite)
+{
+    // A cached texture may have been a placeholder at creation, so its alpha is looked up now
+    if (sprite->texture != RGFX_INVALID_TEXTURE_HANDLE)
+    {
+        return rgfx_internal_texture_has_alpha(sprite->texture);
+    }
+    return sprite->translucent;
+}
+
+static rgfx_sprite_handle rgfx_sprite_create_internal(const rgfx_sprite_desc_t* desc, bool async)
 {
     if (!desc)
     {
@@ -82,7 +84,11 @@ rgfx_sprite_handle rgfx_sprite_create(const rgfx_sprite_desc_t* desc)
     rtransform_set_scale(sprite->transform, scale);
 
     vec3_dup(sprite->size, desc->scale);
-    sprite->color = desc->color;
+    sprite->color      = desc->color;
+    sprite->uv_rect[0] = 0.0f;
+    sprite->uv_rect[1] = 0.0f;
+    sprite->uv_rect[2] = 1.0f;
+    sprite->uv_rect[3] = 1.0f;
 
     if (desc->uniform_count > 0)
     {
@@ -103,57 +109,73 @@ rgfx_sprite_handle rgfx_sprite_create(const rgfx_sprite_desc_t* desc)
         }
     }
 
-    char* vertex_source   = NULL;
-    char* fragment_source = NULL;
+    // Shader text is compiled straight from the asset views; compilation adds any missing #version
+    rasset_view_t vertex_source   = { 0 };
+    rasset_view_t fragment_source = { 0 };
 
-    if (desc->vertex_shader_path)
+    if (desc->vertex_shader_path && !rasset_open(desc->vertex_shader_path, &vertex_source))
     {
-        vertex_source = rgfx_load_shader_source(desc->vertex_shader_path);
-        if (!vertex_source)
-        {
-            rlog_error("Failed to load vertex shader from %s", desc->vertex_shader_path);
-            goto fail;
-        }
+        rlog_error("Failed to load vertex shader from %s", desc->vertex_shader_path);
+        goto fail;
     }
 
-    if (desc->fragment_shader_path)
+    if (desc->fragment_shader_path && !rasset_open(desc->fragment_shader_path, &fragment_source))
     {
-        fragment_source = rgfx_load_shader_source(desc->fragment_shader_path);
-        if (!fragment_source)
-        {
-            rlog_error("Failed to load fragment shader from %s", desc->fragment_shader_path);
-            goto fail;
-        }
+        rlog_error("Failed to load fragment shader from %s", desc->fragment_shader_path);
+        goto fail;
     }
 
-    const char* vertex_ptr   = vertex_source ? vertex_source : rgfx_internal_default_sprite_vertex_shader();
-    const char* fragment_ptr = fragment_source ? fragment_source : rgfx_internal_default_sprite_fragment_shader();
+    const char* vertex_ptr   = vertex_source.data ? (const char*)vertex_source.data : rgfx_internal_default_sprite_vertex_shader();
+    const char* fragment_ptr = fragment_source.data ? (const char*)fragment_source.data : rgfx_internal_default_sprite_fragment_shader();
 
-    sprite->shaderProgram = rgfx_create_shader_program(vertex_ptr, fragment_ptr);
+    sprite->shaderProgram = rgfx_internal_acquire_shader_program(vertex_ptr, fragment_ptr);
 
-    if (vertex_source)
+    rasset_close(&vertex_source);
+    rasset_close(&fragment_source);
+
+    if (sprite->shaderProgram == 0)
     {
-        free(vertex_source);
-        vertex_source = NULL;
+        goto fail;
     }
-    if (fragment_source)
+
+    sprite->program_info = rgfx_internal_program_info(sprite->shaderProgram);
+    for (int i = 0; i < sprite->uniform_count; ++i)
     {
-        free(fragment_source);
-        fragment_source = NULL;
+        sprite->uniform_locations[i] =
+            rgfx_internal_program_uniform_location(sprite->program_info, sprite->uniforms[i].name);
     }
 
-    if (sprite->shaderProgram == 0)
+    bool from_atlas = false;
+    if (desc->atlas != RGFX_INVALID_ATLAS_HANDLE && desc->atlas_region)
     {
-        goto fail;
+        unsigned int               page   = 0;
+        const rgfx_atlas_region_t* region = rgfx_internal_atlas_find_region(desc->atlas, desc->atlas_region, &page);
+        if (region)
+        {
+            rgfx_internal_atlas_retain(desc->atlas);
+            sprite->atlas       = desc->atlas;
+            sprite->textureID   = page;
+            sprite->hasTexture  = true;
+            sprite->translucent = region->has_alpha;
+            memcpy(sprite->uv_rect, region->uv_rect, sizeof(sprite->uv_rect));
+            from_atlas = true;
+        }
+        else
+        {
+            rlog_warning("No atlas region named %s", desc->atlas_region);
+        }
     }
 
-    if (desc->texture_path)
+    // texture_path doubles as the fallback when the atlas could not be built or lacks the region
+    if (!from_atlas && desc->texture_path)
     {
-        unsigned int texture = rgfx_load_texture(desc->texture_path);
-        if (texture > 0)
+        rgfx_texture_handle texture = async ? rgfx_texture_acquire_async(desc->texture_path) : rgfx_texture_acquire(desc->texture_path);
+        if (texture != RGFX_INVALID_TEXTURE_HANDLE)
         {
-            sprite->textureID  = texture;
-            sprite->hasTexture = true;
+            sprite->texture     = texture;
+            sprite->textureID   = rgfx_texture_get_id(texture);
+            sprite->hasTexture  = true;
+            sprite->translucent = rgfx_internal_texture_has_alpha(texture);
         }
         else
         {
@@ -163,65 +185,6 @@ rgfx_sprite_handle rgfx_sprite_create(const rgfx_sprite_desc_t* desc)
         }
     }
 
-    float vertices[16];
-    bool  use_texcoords = false;
-
-    if (glGetAttribLocation(sprite->shaderProgram, "aTexCoord") != -1)
-    {
-        use_texcoords = true;
-        const float textured[] = {
-            -0.5f, -0.5f, 0.0f, 0.0f,
-             0.5f, -0.5f, 1.0f, 0.0f,
-             0.5f,  0.5f, 1.0f, 1.0f,
-            -0.5f,  0.5f, 0.0f, 1.0f,
-        };
-        memcpy(vertices, textured, sizeof(textured));
-    }
-    else
-    {
-        const float positions[] = {
-            -0.5f, -0.5f,
-             0.5f, -0.5f,
-             0.5f,  0.5f,
-            -0.5f,  0.5f,
-        };
-        memcpy(vertices, positions, sizeof(positions));
-    }
-
-    const unsigned int indices[] = { 0, 1, 2, 2, 3, 0 };
-
-    glGenVertexArrays(1, &sprite->VAO);
-    glGenBuffers(1, &sprite->VBO);
-    glGenBuffers(1, &sprite->EBO);
-
-    glBindVertexArray(sprite->VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, sprite->VBO);
-    glBufferData(GL_ARRAY_BUFFER,
-                 use_texcoords ? sizeof(float) * 16 : sizeof(float) * 8,
-                 vertices,
-                 GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sprite->EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-    if (use_texcoords)
-    {
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-    }
-    else
-    {
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-    }
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-
     rgfx_sprite handle = rgfx_internal_sprite_register(sprite);
     if (handle == RGFX_INVALID_SPRITE_HANDLE)
     {
@@ -231,13 +194,35 @@ rgfx_sprite_handle rgfx_sprite_create(const rgfx_sprite_desc_t* desc)
     return handle;
 
 fail:
-    free(vertex_source);
-    free(fragment_source);
+    rasset_close(&vertex_source);
+    rasset_close(&fragment_source);
     rgfx_sprite_release_resources(sprite);
     free(sprite);
     return RGFX_INVALID_SPRITE_HANDLE;
 }
 
+rgfx_sprite_handle rgfx_sprite_create(const rgfx_sprite_desc_t* desc)
+{
+    return rgfx_sprite_create_internal(desc, false);
+}
+
+// Shaders still compile here since they need the GL context; only the texture is deferred
+rgfx_sprite_handle rgfx_sprite_create_async(const rgfx_sprite_desc_t* desc)
+{
+    return rgfx_sprite_create_internal(desc, true);
+}
+
+bool rgfx_sprite_is_ready(rgfx_sprite_handle sprite)
+{
+    rgfx_sprite_t* sprite_ptr = rgfx_sprite_from_handle(sprite);
+    if (!sprite_ptr)
+    {
+        return false;
+    }
+
+    return sprite_ptr->texture == RGFX_INVALID_TEXTURE_HANDLE || rgfx_texture_is_ready(sprite_ptr->texture);
+}
+
 void rgfx_sprite_destroy(rgfx_sprite_handle sprite)
 {
     rgfx_sprite_t* sprite_ptr = rgfx_sprite_from_handle(sprite);
@@ -251,31 +236,20 @@ void rgfx_sprite_destroy(rgfx_sprite_handle sprite)
     free(sprite_ptr);
 }
 
-void rgfx_sprite_draw(rgfx_sprite_handle sprite)
+void rgfx_internal_sprite_apply_uniforms(const rgfx_program_info_t* program, const rgfx_sprite_t* sprite)
 {
-    rgfx_sprite_t* sprite_ptr = rgfx_sprite_from_handle(sprite);
-    if (!sprite_ptr)
+    // Clear what earlier sprites left in the shared program but this one does not set
+    if (!sprite)
     {
+        rgfx_internal_program_reset_uniforms(program, NULL, 0);
         return;
     }
+    rgfx_internal_program_reset_uniforms(program, sprite->uniform_locations, sprite->uniform_count);
 
-    glUseProgram(sprite_ptr->shaderProgram);
-
-    rtransform_update(sprite_ptr->transform);
-    glUniformMatrix4fv(glGetUniformLocation(sprite_ptr->shaderProgram, "uModel"), 1, GL_FALSE, (float*)sprite_ptr->transform->world);
-
-    glUniform2f(glGetUniformLocation(sprite_ptr->shaderProgram, "uSize"), sprite_ptr->size[0], sprite_ptr->size[1]);
-    glUniform3f(glGetUniformLocation(sprite_ptr->shaderProgram, "uColor"), sprite_ptr->color.r, sprite_ptr->color.g, sprite_ptr->color.b);
-
-    float currentTime = rapp_get_time();
-    glUniform1f(glGetUniformLocation(sprite_ptr->shaderProgram, "uTime"), currentTime);
-
-    glUniform1i(glGetUniformLocation(sprite_ptr->shaderProgram, "uUseTexture"), sprite_ptr->hasTexture ? 1 : 0);
-
-    for (int i = 0; i < sprite_ptr->uniform_count; ++i)
+    for (int i = 0; i < sprite->uniform_count; ++i)
     {
-        const rgfx_uniform_t* uniform = &sprite_ptr->uniforms[i];
-        int location = glGetUniformLocation(sprite_ptr->shaderProgram, uniform->name);
+        const rgfx_uniform_t* uniform  = &sprite->uniforms[i];
+        int                   location = sprite->uniform_locations[i];
         if (location == -1)
         {
             continue;
@@ -299,35 +273,52 @@ void rgfx_sprite_draw(rgfx_sprite_handle sprite)
             glUniform4fv(location, 1, uniform->uniform_vec4);
             break;
         }
+        rgfx_internal_program_mark_uniform(program, location);
     }
+}
 
-    rgfx_camera_t* camera = rgfx_internal_get_active_camera();
-    if (camera)
+void rgfx_sprite_draw(rgfx_sprite_handle sprite)
+{
+    rgfx_sprite_t* sprite_ptr = rgfx_sprite_from_handle(sprite);
+    if (!sprite_ptr || !sprite_ptr->program_info)
     {
-        mat4x4 view;
-        mat4x4 projection;
-        rgfx_camera_get_matrices(camera, view, projection);
-        glUniformMatrix4fv(glGetUniformLocation(sprite_ptr->shaderProgram, "uView"), 1, GL_FALSE, (float*)view);
-        glUniformMatrix4fv(glGetUniformLocation(sprite_ptr->shaderProgram, "uProjection"), 1, GL_FALSE, (float*)projection);
+        return;
     }
-    else
+
+    const rgfx_program_info_t* program = sprite_ptr->program_info;
+    if (program->instanced)
     {
-        mat4x4 identity;
-        mat4x4_identity(identity);
-        glUniformMatrix4fv(glGetUniformLocation(sprite_ptr->shaderProgram, "uView"), 1, GL_FALSE, (float*)identity);
-        glUniformMatrix4fv(glGetUniformLocation(sprite_ptr->shaderProgram, "uProjection"), 1, GL_FALSE, (float*)identity);
+        rgfx_internal_batch_push_sprite(sprite_ptr);
+        return;
     }
 
+    rgfx_internal_use_program(sprite_ptr->shaderProgram);
+
+    mat4x4 world;
+    rtransform_get_world_matrix(sprite_ptr->transform, world);
+    glUniformMatrix4fv(program->slots[RGFX_UNIFORM_SLOT_MODEL], 1, GL_FALSE, (float*)world);
+
+    glUniform2f(program->slots[RGFX_UNIFORM_SLOT_SIZE], sprite_ptr->size[0], sprite_ptr->size[1]);
+    glUniform3f(program->slots[RGFX_UNIFORM_SLOT_COLOR], sprite_ptr->color.r, sprite_ptr->color.g, sprite_ptr->color.b);
+
+    glUniform1i(program->slots[RGFX_UNIFORM_SLOT_USE_TEXTURE], sprite_ptr->hasTexture ? 1 : 0);
+    glUniform4fv(program->slots[RGFX_UNIFORM_SLOT_UV_RECT], 1, sprite_ptr->uv_rect);
+
+    rgfx_internal_sprite_apply_uniforms(program, sprite_ptr);
+
+    rgfx_internal_program_upload_frame(program);
+
     if (sprite_ptr->hasTexture)
     {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, sprite_ptr->textureID);
-        glUniform1i(glGetUniformLocation(sprite_ptr->shaderProgram, "uTexture"), 0);
+        rgfx_internal_bind_texture(0, sprite_ptr->textureID);
+        glUniform1i(program->slots[RGFX_UNIFORM_SLOT_TEXTURE], 0);
     }
 
-    glBindVertexArray(sprite_ptr->VAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    rgfx_internal_bind_vertex_array(rgfx_internal_quad_geometry()->VAO);
+    glDrawElements(GL_TRIANGLES, RGFX_QUAD_INDEX_COUNT, GL_UNSIGNED_INT, 0);
+
+    rgfx_internal_stats_count_draw(false);
+    rgfx_internal_stats_count_sprites(1);
 }
 
 void rgfx_sprite_set_position(rgfx_sprite_handle sprite, vec3 position)
@@ -374,8 +365,28 @@ void rgfx_sprite_set_texture(rgfx_sprite_handle sprite, unsigned int textureID)
         return;
     }
 
-    sprite_ptr->textureID  = textureID;
-    sprite_ptr->hasTexture = textureID != 0;
+    // Externally supplied textures are not owned; drop the cached one the sprite was created with
+    if (sprite_ptr->texture != RGFX_INVALID_TEXTURE_HANDLE)
+    {
+        rgfx_texture_release(sprite_ptr->texture);
+        sprite_ptr->texture = RGFX_INVALID_TEXTURE_HANDLE;
+    }
+
+    // An atlas region's UV rect belongs to its page, not to the new texture
+    if (sprite_ptr->atlas != RGFX_INVALID_ATLAS_HANDLE)
+    {
+        rgfx_atlas_release(sprite_ptr->atlas);
+        sprite_ptr->atlas = RGFX_INVALID_ATLAS_HANDLE;
+    }
+    sprite_ptr->uv_rect[0] = 0.0f;
+    sprite_ptr->uv_rect[1] = 0.0f;
+    sprite_ptr->uv_rect[2] = 1.0f;
+    sprite_ptr->uv_rect[3] = 1.0f;
+
+    // The format of a caller's texture is unknown, so assume it may blend
+    sprite_ptr->textureID   = textureID;
+    sprite_ptr->hasTexture  = textureID != 0;
+    sprite_ptr->translucent = textureID != 0;
 }
 
 void rgfx_sprite_get_position(rgfx_sprite_handle sprite, vec3 out_position)
@@ -454,6 +465,8 @@ static void rgfx_sprite_set_uniform(rgfx_sprite_handle sprite, const char* name,
 
     sprite_ptr->uniforms[sprite_ptr->uniform_count] = *new_uniform;
     sprite_ptr->uniforms[sprite_ptr->uniform_count].name = name;
+    sprite_ptr->uniform_locations[sprite_ptr->uniform_count] =
+        rgfx_internal_program_uniform_location(sprite_ptr->program_info, name);
     sprite_ptr->uniform_count++;
 }
 
@@ -543,6 +556,47 @@ void rgfx_sprite_set_rotation(rgfx_sprite_handle sprite, float rotation)
     rtransform_set_rotation_axis_angle(sprite_ptr->transform, axis, rotation);
 }
 
+static void rgfx_sprite_gather_transforms(const rgfx_sprite_handle* sprites, uint32_t count, rtransform_t** out_transforms)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        rgfx_sprite_t* sprite_ptr = rgfx_sprite_from_handle(sprites[i]);
+        out_transforms[i]         = sprite_ptr ? sprite_ptr->transform : NULL;
+    }
+}
+
+void rgfx_sprite_set_positions(const rgfx_sprite_handle* sprites, const float* positions, uint32_t count)
+{
+    if (!sprites || !positions)
+    {
+        return;
+    }
+
+    rtransform_t* transforms[RGFX_SPRITE_BULK_CHUNK];
+    for (uint32_t base = 0; base < count; base += RGFX_SPRITE_BULK_CHUNK)
+    {
+        uint32_t chunk = count - base < RGFX_SPRITE_BULK_CHUNK ? count - base : RGFX_SPRITE_BULK_CHUNK;
+        rgfx_sprite_gather_transforms(sprites + base, chunk, transforms);
+        rtransform_set_positions(transforms, positions + (size_t)base * 3u, chunk);
+    }
+}
+
+void rgfx_sprite_set_rotations(const rgfx_sprite_handle* sprites, const float* rotations, uint32_t count)
+{
+    if (!sprites || !rotations)
+    {
+        return;
+    }
+
+    rtransform_t* transforms[RGFX_SPRITE_BULK_CHUNK];
+    for (uint32_t base = 0; base < count; base += RGFX_SPRITE_BULK_CHUNK)
+    {
+        uint32_t chunk = count - base < RGFX_SPRITE_BULK_CHUNK ? count - base : RGFX_SPRITE_BULK_CHUNK;
+        rgfx_sprite_gather_transforms(sprites + base, chunk, transforms);
+        rtransform_set_rotations_z(transforms, rotations + base, chunk);
+    }
+}
+
 void rgfx_sprite_get_world_position(rgfx_sprite_handle sprite, vec3 out_position)
 {
     if (!out_position)
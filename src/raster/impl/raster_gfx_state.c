@@ -0,0 +1,184 @@
+#include "raster_gfx_internal.h"
+
+#include <string.h>
+
+#define RGFX_STATE_UNKNOWN 0xFFFFFFFFu
+
+typedef enum
+{
+    RGFX_TOGGLE_UNKNOWN = -1,
+    RGFX_TOGGLE_OFF     = 0,
+    RGFX_TOGGLE_ON      = 1,
+} rgfx_toggle_t;
+
+/* Mirror of the GL state the engine touches; RGFX_STATE_UNKNOWN forces the next call through */
+static struct
+{
+    unsigned int  program;
+    unsigned int  vertex_array;
+    unsigned int  active_unit;
+    unsigned int  textures[RGFX_MAX_TEXTURE_UNITS];
+    rgfx_toggle_t blend;
+    GLenum        blend_src;
+    GLenum        blend_dst;
+    rgfx_toggle_t depth_test;
+    rgfx_toggle_t depth_write;
+} g_state;
+
+static inline bool rgfx_state_skip(bool redundant)
+{
+    rgfx_internal_stats_count_state_change(redundant);
+    return redundant;
+}
+
+void rgfx_internal_state_reset(void)
+{
+    g_state.program      = RGFX_STATE_UNKNOWN;
+    g_state.vertex_array = RGFX_STATE_UNKNOWN;
+    g_state.active_unit  = RGFX_STATE_UNKNOWN;
+    for (int unit = 0; unit < RGFX_MAX_TEXTURE_UNITS; ++unit)
+    {
+        g_state.textures[unit] = RGFX_STATE_UNKNOWN;
+    }
+    g_state.blend       = RGFX_TOGGLE_UNKNOWN;
+    g_state.blend_src   = GL_NONE;
+    g_state.blend_dst   = GL_NONE;
+    g_state.depth_test  = RGFX_TOGGLE_UNKNOWN;
+    g_state.depth_write = RGFX_TOGGLE_UNKNOWN;
+}
+
+void rgfx_internal_use_program(unsigned int program)
+{
+    if (rgfx_state_skip(g_state.program == program))
+    {
+        return;
+    }
+
+    glUseProgram(program);
+    g_state.program = program;
+}
+
+void rgfx_internal_bind_vertex_array(unsigned int vertex_array)
+{
+    if (rgfx_state_skip(g_state.vertex_array == vertex_array))
+    {
+        return;
+    }
+
+    glBindVertexArray(vertex_array);
+    g_state.vertex_array = vertex_array;
+}
+
+void rgfx_internal_bind_texture(unsigned int unit, unsigned int texture)
+{
+    if (unit >= RGFX_MAX_TEXTURE_UNITS)
+    {
+        rlog_error("rgfx: texture unit %u out of range (max %d)", unit, RGFX_MAX_TEXTURE_UNITS);
+        return;
+    }
+
+    if (rgfx_state_skip(g_state.textures[unit] == texture))
+    {
+        return;
+    }
+
+    if (g_state.active_unit != unit)
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        g_state.active_unit = unit;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    g_state.textures[unit] = texture;
+    rgfx_internal_stats_count_texture_bind();
+}
+
+void rgfx_internal_set_blend(bool enabled)
+{
+    rgfx_toggle_t wanted = enabled ? RGFX_TOGGLE_ON : RGFX_TOGGLE_OFF;
+    if (rgfx_state_skip(g_state.blend == wanted))
+    {
+        return;
+    }
+
+    if (enabled)
+    {
+        glEnable(GL_BLEND);
+    }
+    else
+    {
+        glDisable(GL_BLEND);
+    }
+    g_state.blend = wanted;
+}
+
+void rgfx_internal_set_blend_func(GLenum src, GLenum dst)
+{
+    if (rgfx_state_skip(g_state.blend_src == src && g_state.blend_dst == dst))
+    {
+        return;
+    }
+
+    glBlendFunc(src, dst);
+    g_state.blend_src = src;
+    g_state.blend_dst = dst;
+}
+
+void rgfx_internal_set_depth_test(bool enabled)
+{
+    rgfx_toggle_t wanted = enabled ? RGFX_TOGGLE_ON : RGFX_TOGGLE_OFF;
+    if (rgfx_state_skip(g_state.depth_test == wanted))
+    {
+        return;
+    }
+
+    if (enabled)
+    {
+        glEnable(GL_DEPTH_TEST);
+    }
+    else
+    {
+        glDisable(GL_DEPTH_TEST);
+    }
+    g_state.depth_test = wanted;
+}
+
+void rgfx_internal_set_depth_write(bool enabled)
+{
+    rgfx_toggle_t wanted = enabled ? RGFX_TOGGLE_ON : RGFX_TOGGLE_OFF;
+    if (rgfx_state_skip(g_state.depth_write == wanted))
+    {
+        return;
+    }
+
+    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    g_state.depth_write = wanted;
+}
+
+/* GL unbinds deleted objects and may hand their names out again, so drop them from the mirror */
+void rgfx_internal_state_forget_program(unsigned int program)
+{
+    if (g_state.program == program)
+    {
+        g_state.program = RGFX_STATE_UNKNOWN;
+    }
+}
+
+void rgfx_internal_state_forget_vertex_array(unsigned int vertex_array)
+{
+    if (g_state.vertex_array == vertex_array)
+    {
+        g_state.vertex_array = RGFX_STATE_UNKNOWN;
+    }
+}
+
+void rgfx_internal_state_forget_texture(unsigned int texture)
+{
+    for (int unit = 0; unit < RGFX_MAX_TEXTURE_UNITS; ++unit)
+    {
+        if (g_state.textures[unit] == texture)
+        {
+            g_state.textures[unit] = RGFX_STATE_UNKNOWN;
+        }
+    }
+}
@@ -1,95 +1,285 @@
 #include "raster_gfx_internal.h"
+#include "raster/raster_job.h"
 
 #include <stdlib.h>
-#include <stdio.h>
 #include <string.h>
 
-#define STB_TRUETYPE_IMPLEMENTATION
-#include <stb/stb_truetype.h>
+#define RGFX_TEXT_BITMAP_PADDING   10
+#define RGFX_TEXT_FLOATS_PER_GLYPH 16
+#define RGFX_UTF8_REPLACEMENT      0xFFFD
 
-#define RGFX_TEXT_BITMAP_PADDING 10
+/* One laid-out line: a span of the text without its newline, carved from the scratch arena */
+typedef struct
+{
+    uint32_t start;
+    uint32_t length;
+    float    width;
+} rgfx_text_line_t;
 
 typedef struct
 {
-    char** lines;
-    int    count;
-} rgfx_text_lines_t;
+    rgfx_text_handle handle;
+    char*            font_path;
+    rgfx_font_t*     font; /* detached until adopted on the main thread */
+} rgfx_text_job_t;
 
-static rgfx_text_lines_t rgfx_split_text_into_lines(const char* text)
+/* Decodes one UTF-8 sequence at *cursor and advances past it; malformed input yields U+FFFD and skips one byte */
+static int rgfx_utf8_next(const char** cursor, const char* end)
 {
-    rgfx_text_lines_t result = { NULL, 0 };
-    if (!text)
+    const unsigned char* p    = (const unsigned char*)*cursor;
+    const unsigned char  lead = p[0];
+
+    int      length;
+    uint32_t codepoint;
+    uint32_t minimum;
+    if (lead < 0x80u)
+    {
+        *cursor += 1;
+        return (int)lead;
+    }
+    else if ((lead & 0xE0u) == 0xC0u)
+    {
+        length    = 2;
+        codepoint = lead & 0x1Fu;
+        minimum   = 0x80u;
+    }
+    else if ((lead & 0xF0u) == 0xE0u)
+    {
+        length    = 3;
+        codepoint = lead & 0x0Fu;
+        minimum   = 0x800u;
+    }
+    else if ((lead & 0xF8u) == 0xF0u)
     {
-        return result;
+        length    = 4;
+        codepoint = lead & 0x07u;
+        minimum   = 0x10000u;
+    }
+    else
+    {
+        *cursor += 1;
+        return RGFX_UTF8_REPLACEMENT;
     }
 
-    int line_count = 1;
-    for (const char* p = text; *p; ++p)
+    if (end - *cursor < length)
     {
-        if (*p == '\n')
+        *cursor += 1;
+        return RGFX_UTF8_REPLACEMENT;
+    }
+
+    for (int i = 1; i < length; ++i)
+    {
+        if ((p[i] & 0xC0u) != 0x80u)
         {
-            line_count++;
+            *cursor += 1;
+            return RGFX_UTF8_REPLACEMENT;
         }
+        codepoint = (codepoint << 6) | (p[i] & 0x3Fu);
     }
 
-    result.lines = (char**)malloc((size_t)line_count * sizeof(char*));
-    if (!result.lines)
+    // Overlong forms, UTF-16 surrogates and values past U+10FFFF are not valid scalar values
+    if (codepoint < minimum || (codepoint >= 0xD800u && codepoint <= 0xDFFFu) || codepoint > 0x10FFFFu)
     {
-        return result;
+        *cursor += 1;
+        return RGFX_UTF8_REPLACEMENT;
     }
 
-    result.count = line_count;
+    *cursor += length;
+    return (int)codepoint;
+}
+
+static rgfx_text_t* rgfx_text_from_handle(rgfx_text_handle handle)
+{
+    return rgfx_internal_text_resolve(handle);
+}
+
+static bool rgfx_text_update_bitmap_ptr(rgfx_text_t* text);
+
+static bool rgfx_text_assign(rgfx_text_t* text, const char* source)
+{
+    size_t length = strlen(source);
+    if (length >= UINT32_MAX / 2u)
+    {
+        return false;
+    }
 
-    const char* start      = text;
-    int         line_index = 0;
-    for (const char* p = text;; ++p)
+    if (length + 1u > text->text_capacity)
     {
-        if (*p == '\n' || *p == '\0')
+        uint32_t new_capacity = text->text_capacity ? text->text_capacity : 64u;
+        while (new_capacity < length + 1u)
         {
-            size_t len = (size_t)(p - start);
-            result.lines[line_index] = (char*)malloc(len + 1);
-            if (result.lines[line_index])
-            {
-                strncpy(result.lines[line_index], start, len);
-                result.lines[line_index][len] = '\0';
-            }
-            start = p + 1;
-            line_index++;
+            new_capacity *= 2u;
         }
 
-        if (*p == '\0')
+        char* buffer = (char*)realloc(text->text, new_capacity);
+        if (!buffer)
         {
-            break;
+            return false;
         }
+        text->text          = buffer;
+        text->text_capacity = new_capacity;
     }
 
-    return result;
+    memcpy(text->text, source, length + 1u);
+    text->text_length = (uint32_t)length;
+    return true;
 }
 
-static void rgfx_free_text_lines(rgfx_text_lines_t* lines)
+/* Per-object scratch memory for layout; its contents do not survive the next call */
+static void* rgfx_text_scratch(rgfx_text_t* text, size_t bytes)
 {
-    if (!lines || !lines->lines)
+    if (bytes > text->scratch_capacity)
     {
-        return;
+        size_t new_capacity = text->scratch_capacity ? text->scratch_capacity : 256u;
+        while (new_capacity < bytes)
+        {
+            new_capacity *= 2u;
+        }
+
+        // Nothing in the old block needs keeping, so skip the copy realloc would make
+        void* scratch = malloc(new_capacity);
+        if (!scratch)
+        {
+            return NULL;
+        }
+        free(text->scratch);
+        text->scratch          = scratch;
+        text->scratch_capacity = new_capacity;
     }
 
-    for (int i = 0; i < lines->count; ++i)
+    return text->scratch;
+}
+
+static inline float rgfx_text_atlas_height(const rgfx_text_t* text)
+{
+    return text->sdf ? RGFX_GLYPH_SDF_PIXEL_HEIGHT : text->font_size;
+}
+
+/* SDF atlases and their metrics are at a fixed height; bitmap ones match the text size and this is 1 */
+static inline float rgfx_text_glyph_scale(const rgfx_text_t* text)
+{
+    return text->font_size / text->atlas->pixel_height;
+}
+
+static void rgfx_text_free(rgfx_text_t* text)
+{
+    if (text->VAO)
     {
-        free(lines->lines[i]);
+        rgfx_internal_state_forget_vertex_array(text->VAO);
+        glDeleteVertexArrays(1, &text->VAO);
     }
-    free(lines->lines);
-    lines->lines = NULL;
-    lines->count = 0;
+    if (text->VBO)
+    {
+        glDeleteBuffers(1, &text->VBO);
+    }
+    if (text->shaderProgram)
+    {
+        rgfx_internal_release_shader_program(text->shaderProgram);
+    }
+    rgfx_internal_glyph_atlas_release(text->atlas);
+    rgfx_internal_font_release(text->font);
+    if (text->transform)
+    {
+        rtransform_destroy(text->transform);
+    }
+
+    free(text->vertices);
+    free(text->scratch);
+    free(text->text);
+    free(text);
 }
 
-static rgfx_text_t* rgfx_text_from_handle(rgfx_text_handle handle)
+static bool rgfx_text_create_buffers(rgfx_text_t* text)
 {
-    return rgfx_internal_text_resolve(handle);
+    glGenVertexArrays(1, &text->VAO);
+    glGenBuffers(1, &text->VBO);
+    if (!text->VAO || !text->VBO)
+    {
+        return false;
+    }
+
+    rgfx_internal_bind_vertex_array(text->VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, text->VBO);
+    glVertexAttribPointer(RGFX_ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(RGFX_ATTRIB_POSITION);
+    glVertexAttribPointer(RGFX_ATTRIB_TEXCOORD, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(RGFX_ATTRIB_TEXCOORD);
+
+    rgfx_internal_bind_vertex_array(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return true;
 }
 
-static bool rgfx_text_update_bitmap_ptr(rgfx_text_t* text);
+/* Shared by both create paths once the font is known: glyphs for the text's size, then layout */
+static bool rgfx_text_attach_font(rgfx_text_t* text, rgfx_font_t* font)
+{
+    text->font  = font;
+    text->atlas = rgfx_internal_glyph_atlas_acquire(text->font, rgfx_text_atlas_height(text), text->sdf);
+    return text->atlas != NULL;
+}
 
-rgfx_text_handle rgfx_text_create(const rgfx_text_desc_t* desc)
+static void rgfx_text_job_work(void* user)
+{
+    rgfx_text_job_t* job = (rgfx_text_job_t*)user;
+    job->font            = rgfx_internal_font_load_detached(job->font_path);
+}
+
+static void rgfx_text_job_complete(void* user)
+{
+    rgfx_text_job_t* job  = (rgfx_text_job_t*)user;
+    rgfx_text_t*     text = rgfx_text_from_handle(job->handle);
+
+    if (!text)
+    {
+        rgfx_internal_font_discard(job->font);
+    }
+    else
+    {
+        rgfx_font_t* font = rgfx_internal_font_adopt(job->font);
+        if (!font)
+        {
+            // The text stays valid but empty, as if its string had no glyphs
+            rlog_error("rgfx: text %u has no font, %s failed to load", (unsigned)job->handle, job->font_path);
+        }
+        else if (rgfx_text_attach_font(text, font))
+        {
+            rgfx_text_update_bitmap_ptr(text);
+        }
+    }
+
+    free(job->font_path);
+    free(job);
+}
+
+static bool rgfx_text_load_async(rgfx_text_handle handle, const char* font_path)
+{
+    rgfx_text_job_t* job = (rgfx_text_job_t*)calloc(1, sizeof(rgfx_text_job_t));
+    if (!job)
+    {
+        return false;
+    }
+
+    job->handle    = handle;
+    job->font_path = (char*)malloc(strlen(font_path) + 1);
+    if (!job->font_path)
+    {
+        free(job);
+        return false;
+    }
+    strcpy(job->font_path, font_path);
+
+    if (!rjob_submit(rgfx_text_job_work, rgfx_text_job_complete, job))
+    {
+        free(job->font_path);
+        free(job);
+        return false;
+    }
+    return true;
+}
+
+static rgfx_text_handle rgfx_text_create_internal(const rgfx_text_desc_t* desc, bool async)
 {
     if (!desc || !desc->font_path || !desc->text)
     {
@@ -107,14 +297,12 @@ rgfx_text_handle rgfx_text_create(const rgfx_text_desc_t* desc)
     text->font_size    = desc->font_size;
     text->text_color   = desc->text_color;
     text->alignment    = desc->alignment;
-
-    strncpy(text->text, desc->text, RGFX_MAX_TEXT_LENGTH - 1);
-    text->text[RGFX_MAX_TEXT_LENGTH - 1] = '\0';
+    text->sdf          = desc->sdf;
 
     text->transform = rtransform_create();
-    if (!text->transform)
+    if (!text->transform || !rgfx_text_assign(text, desc->text))
     {
-        free(text);
+        rgfx_text_free(text);
         return RGFX_INVALID_TEXT_HANDLE;
     }
 
@@ -125,113 +313,65 @@ rgfx_text_handle rgfx_text_create(const rgfx_text_desc_t* desc)
     vec3 scale = { desc->font_size * 0.04f, desc->font_size * -0.04f, 1.0f };
     rtransform_set_scale(text->transform, scale);
 
-    FILE* font_file = fopen(desc->font_path, "rb");
-    if (!font_file)
+    // Async texts get their font, glyph atlas and layout when the load job completes
+    if (!async)
     {
-        rtransform_destroy(text->transform);
-        free(text);
-        return RGFX_INVALID_TEXT_HANDLE;
+        rgfx_font_t* font = rgfx_internal_font_acquire(desc->font_path);
+        // On failure the text holds whatever it acquired, so freeing it releases that
+        if (!font || !rgfx_text_attach_font(text, font))
+        {
+            rgfx_text_free(text);
+            return RGFX_INVALID_TEXT_HANDLE;
+        }
     }
 
-    fseek(font_file, 0, SEEK_END);
-    long font_size_bytes = ftell(font_file);
-    fseek(font_file, 0, SEEK_SET);
-
-    text->font_buffer = (unsigned char*)malloc((size_t)font_size_bytes);
-    if (!text->font_buffer)
+    const char* fragment_source = text->sdf ? rgfx_internal_default_text_sdf_fragment_shader()
+                                            : rgfx_internal_default_text_fragment_shader();
+    text->shaderProgram = rgfx_internal_acquire_shader_program(rgfx_internal_default_text_vertex_shader(), fragment_source);
+    text->program_info  = rgfx_internal_program_info(text->shaderProgram);
+    if (!text->shaderProgram)
     {
-        fclose(font_file);
-        rtransform_destroy(text->transform);
-        free(text);
+        rgfx_text_free(text);
         return RGFX_INVALID_TEXT_HANDLE;
     }
 
-    fread(text->font_buffer, 1, (size_t)font_size_bytes, font_file);
-    fclose(font_file);
-
-    text->font_info = (stbtt_fontinfo*)calloc(1, sizeof(stbtt_fontinfo));
-    if (!text->font_info)
+    if (!rgfx_text_create_buffers(text) || (!async && !rgfx_text_update_bitmap_ptr(text)))
     {
-        free(text->font_buffer);
-        rtransform_destroy(text->transform);
-        free(text);
+        rgfx_text_free(text);
         return RGFX_INVALID_TEXT_HANDLE;
     }
 
-    if (!stbtt_InitFont(text->font_info, text->font_buffer, 0))
+    rgfx_text handle = rgfx_internal_text_register(text);
+    if (handle == RGFX_INVALID_TEXT_HANDLE)
     {
-        free(text->font_info);
-        free(text->font_buffer);
-        rtransform_destroy(text->transform);
-        free(text);
+        rgfx_text_free(text);
         return RGFX_INVALID_TEXT_HANDLE;
     }
 
-    const float quad_vertices[] = {
-        -0.5f, -0.5f, 0.0f, 0.0f,
-         0.5f, -0.5f, 1.0f, 0.0f,
-         0.5f,  0.5f, 1.0f, 1.0f,
-        -0.5f,  0.5f, 0.0f, 1.0f,
-    };
-
-    const unsigned int quad_indices[] = { 0, 1, 2, 2, 3, 0 };
-
-    text->shaderProgram = rgfx_internal_acquire_text_shader_program();
-    if (!text->shaderProgram)
+    if (async && !rgfx_text_load_async(handle, desc->font_path))
     {
-        free(text->font_info);
-        free(text->font_buffer);
-        rtransform_destroy(text->transform);
-        free(text);
+        rgfx_internal_text_unregister(handle);
+        rgfx_text_free(text);
         return RGFX_INVALID_TEXT_HANDLE;
     }
 
-    glGenVertexArrays(1, &text->VAO);
-    glGenBuffers(1, &text->VBO);
-    glGenBuffers(1, &text->EBO);
-
-    glBindVertexArray(text->VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, text->VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(quad_vertices), quad_vertices, GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, text->EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(quad_indices), quad_indices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    return handle;
+}
 
-    if (!rgfx_text_update_bitmap_ptr(text))
-    {
-        glDeleteVertexArrays(1, &text->VAO);
-        glDeleteBuffers(1, &text->VBO);
-        glDeleteBuffers(1, &text->EBO);
-        rgfx_internal_release_text_shader_program();
-        free(text->font_info);
-        free(text->font_buffer);
-        rtransform_destroy(text->transform);
-        free(text);
-        return RGFX_INVALID_TEXT_HANDLE;
-    }
+rgfx_text_handle rgfx_text_create(const rgfx_text_desc_t* desc)
+{
+    return rgfx_text_create_internal(desc, false);
+}
 
-    rgfx_text handle = rgfx_internal_text_register(text);
-    if (handle == RGFX_INVALID_TEXT_HANDLE)
-    {
-        glDeleteVertexArrays(1, &text->VAO);
-        glDeleteBuffers(1, &text->VBO);
-        glDeleteBuffers(1, &text->EBO);
-        rgfx_internal_release_text_shader_program();
-        free(text->font_info);
-        free(text->font_buffer);
-        rtransform_destroy(text->transform);
-        free(text);
-        return RGFX_INVALID_TEXT_HANDLE;
-    }
+rgfx_text_handle rgfx_text_create_async(const rgfx_text_desc_t* desc)
+{
+    return rgfx_text_create_internal(desc, true);
+}
 
-    return handle;
+bool rgfx_text_is_ready(rgfx_text_handle handle)
+{
+    rgfx_text_t* text = rgfx_text_from_handle(handle);
+    return text ? text->atlas != NULL : false;
 }
 
 void rgfx_text_destroy(rgfx_text_handle handle)
@@ -243,253 +383,325 @@ void rgfx_text_destroy(rgfx_text_handle handle)
     }
 
     rgfx_internal_text_unregister(handle);
-
-    if (text->font_buffer)
-    {
-        free(text->font_buffer);
-    }
-    if (text->font_bitmap)
-    {
-        free(text->font_bitmap);
-    }
-    if (text->font_info)
-    {
-        free(text->font_info);
-    }
-    if (text->textureID)
-    {
-        glDeleteTextures(1, &text->textureID);
-    }
-    if (text->transform)
-    {
-        rtransform_destroy(text->transform);
-    }
-
-    glDeleteVertexArrays(1, &text->VAO);
-    glDeleteBuffers(1, &text->VBO);
-    glDeleteBuffers(1, &text->EBO);
-    rgfx_internal_release_text_shader_program();
-
-    free(text);
+    rgfx_text_free(text);
 }
 
 void rgfx_text_draw(rgfx_text_handle handle)
 {
     rgfx_text_t* text = rgfx_text_from_handle(handle);
-    if (!text)
+    if (!text || !text->atlas)
     {
         return;
     }
 
-    glUseProgram(text->shaderProgram);
+    // Growing the atlas renormalizes every UV, so quads built against the old size are stale
+    if (text->atlas_generation != text->atlas->generation)
+    {
+        rgfx_text_update_bitmap_ptr(text);
+    }
 
-    rtransform_update(text->transform);
+    if (text->glyph_count == 0)
+    {
+        return;
+    }
 
-    mat4x4 bitmap_scale;
-    mat4x4_identity(bitmap_scale);
+    if (rgfx_internal_text_batch_push(text))
+    {
+        return;
+    }
 
-    float aspect_ratio = text->bitmap_height > 0 ? (float)text->bitmap_width / (float)text->bitmap_height : 1.0f;
-    bitmap_scale[0][0] = aspect_ratio;
+    const rgfx_program_info_t* program = text->program_info;
 
-    mat4x4 final_transform;
-    mat4x4_mul(final_transform, text->transform->world, bitmap_scale);
+    rgfx_internal_use_program(text->shaderProgram);
 
-    glUniformMatrix4fv(glGetUniformLocation(text->shaderProgram, "uModel"), 1, GL_FALSE, (float*)final_transform);
+    mat4x4 world;
+    rtransform_get_world_matrix(text->transform, world);
+    glUniformMatrix4fv(program->slots[RGFX_UNIFORM_SLOT_MODEL], 1, GL_FALSE, (float*)world);
 
-    glUniform3f(glGetUniformLocation(text->shaderProgram, "uColor"),
+    glUniform3f(program->slots[RGFX_UNIFORM_SLOT_COLOR],
                 text->text_color.r,
                 text->text_color.g,
                 text->text_color.b);
 
-    rgfx_camera_t* camera = rgfx_internal_get_active_camera();
-    if (camera)
-    {
-        mat4x4 view;
-        mat4x4 projection;
-        rgfx_camera_get_matrices(camera, view, projection);
-        glUniformMatrix4fv(glGetUniformLocation(text->shaderProgram, "uView"), 1, GL_FALSE, (float*)view);
-        glUniformMatrix4fv(glGetUniformLocation(text->shaderProgram, "uProjection"), 1, GL_FALSE, (float*)projection);
-    }
-    else
-    {
-        mat4x4 identity;
-        mat4x4_identity(identity);
-        glUniformMatrix4fv(glGetUniformLocation(text->shaderProgram, "uView"), 1, GL_FALSE, (float*)identity);
-        glUniformMatrix4fv(glGetUniformLocation(text->shaderProgram, "uProjection"), 1, GL_FALSE, (float*)identity);
-    }
+    rgfx_internal_program_upload_frame(program);
+
+    rgfx_internal_bind_texture(0, text->atlas->texture);
+    glUniform1i(program->slots[RGFX_UNIFORM_SLOT_TEXTURE], 0);
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, text->textureID);
-    glUniform1i(glGetUniformLocation(text->shaderProgram, "uTexture"), 0);
+    rgfx_internal_bind_vertex_array(text->VAO);
+    glDrawElements(GL_TRIANGLES, (GLsizei)(text->glyph_count * RGFX_QUAD_INDEX_COUNT), GL_UNSIGNED_INT, 0);
 
-    glBindVertexArray(text->VAO);
-    glDrawElements(GL_TRIANGLES, (GLsizei)text->index_count, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    rgfx_internal_stats_count_draw(false);
+    rgfx_internal_stats_count_texts(1);
 }
 
-static bool rgfx_text_update_bitmap_ptr(rgfx_text_t* text)
+static bool rgfx_text_reserve_glyphs(rgfx_text_t* text, uint32_t count)
 {
-    if (!text || !text->font_info)
+    if (count <= text->glyph_capacity)
     {
-        return false;
+        return true;
     }
 
-    if (text->font_bitmap)
+    uint32_t new_capacity = text->glyph_capacity ? text->glyph_capacity : 16u;
+    while (new_capacity < count)
     {
-        free(text->font_bitmap);
-        text->font_bitmap = NULL;
+        new_capacity *= 2u;
     }
 
-    rgfx_text_lines_t lines = rgfx_split_text_into_lines(text->text);
-    if (lines.count == 0)
+    float* vertices = (float*)realloc(text->vertices, (size_t)new_capacity * RGFX_TEXT_FLOATS_PER_GLYPH * sizeof(float));
+    if (!vertices)
     {
         return false;
     }
 
-    float scale = stbtt_ScaleForPixelHeight(text->font_info, text->font_size);
+    text->vertices       = vertices;
+    text->glyph_capacity = new_capacity;
+    return true;
+}
 
-    int ascent, descent, line_gap;
-    stbtt_GetFontVMetrics(text->font_info, &ascent, &descent, &line_gap);
+/* Index range of glyph quads whose vertices changed since the last upload */
+typedef struct
+{
+    uint32_t first;
+    uint32_t end;
+} rgfx_text_dirty_t;
+
+/*
+    Writes one quad per visible glyph; positions are in text pixels, normalized by the layout height.
+    Quads that come out identical to the previous layout are left alone, so the dirty range only covers
+    what actually moved or changed.
+*/
+static void rgfx_text_build_quads(rgfx_text_t*            text,
+                                  const rgfx_text_line_t* lines,
+                                  uint32_t                line_count,
+                                  rgfx_font_metrics_t*    metrics,
+                                  float                   line_height,
+                                  rgfx_text_dirty_t*      dirty)
+{
+    const uint32_t previous_count = text->glyph_count;
 
-    int rounded_ascent   = (int)(ascent * scale + 0.5f);
-    int rounded_descent  = (int)(descent * scale - 0.5f);
+    const rgfx_glyph_atlas_t* atlas       = text->atlas;
+    const float               half_width  = (float)text->layout_width * 0.5f;
+    const float               half_height = (float)text->layout_height * 0.5f;
+    const float               inv_height  = 1.0f / (float)text->layout_height;
+    const float               inv_atlas_w = 1.0f / (float)atlas->width;
+    const float               inv_atlas_h = 1.0f / (float)atlas->height;
+    const float               glyph_scale = rgfx_text_glyph_scale(text);
 
-    float line_spacing = text->line_spacing > 0 ? text->line_spacing : 1.2f;
-    int   line_height  = (int)(((rounded_ascent - rounded_descent) * line_spacing) + 0.5f);
+    text->glyph_count = 0;
 
-    int total_width = 0;
-    int* line_widths = (int*)calloc((size_t)lines.count, sizeof(int));
-    if (!line_widths)
+    float y = (float)metrics->ascent * glyph_scale;
+    for (uint32_t line_index = 0; line_index < line_count; ++line_index)
     {
-        rgfx_free_text_lines(&lines);
-        return false;
-    }
+        const rgfx_text_line_t* line = &lines[line_index];
 
-    for (int i = 0; i < lines.count; ++i)
-    {
-        int line_width = 0;
-        for (const char* p = lines.lines[i]; *p; ++p)
+        float x = (float)(RGFX_TEXT_BITMAP_PADDING / 2);
+        if (text->alignment == RGFX_TEXT_ALIGN_CENTER)
+        {
+            x = floorf(((float)text->layout_width - line->width) * 0.5f);
+        }
+        else if (text->alignment == RGFX_TEXT_ALIGN_RIGHT)
         {
-            int advance = 0;
-            int lsb     = 0;
-            stbtt_GetCodepointHMetrics(text->font_info, (int)*p, &advance, &lsb);
+            x = (float)text->layout_width - line->width - (float)(RGFX_TEXT_BITMAP_PADDING / 2);
+        }
 
-            line_width += (int)(advance * scale + 0.5f);
+        const char* cursor    = text->text + line->start;
+        const char* end       = cursor + line->length;
+        int         codepoint = cursor < end ? rgfx_utf8_next(&cursor, end) : -1;
+        while (codepoint >= 0)
+        {
+            int next = cursor < end ? rgfx_utf8_next(&cursor, end) : -1;
 
-            if (*(p + 1))
+            const rgfx_glyph_t* glyph = rgfx_internal_glyph_atlas_get(text->atlas, codepoint);
+            if (glyph && glyph->x1 > glyph->x0 && glyph->y1 > glyph->y0)
             {
-                int kern = stbtt_GetCodepointKernAdvance(text->font_info, (int)*p, (int)*(p + 1));
-                line_width += (int)(kern * scale + 0.5f);
+                float px0 = (x + (float)glyph->offset_x * glyph_scale - half_width) * inv_height;
+                float py0 = (y + (float)glyph->offset_y * glyph_scale - half_height) * inv_height;
+                float px1 = px0 + (float)(glyph->x1 - glyph->x0) * glyph_scale * inv_height;
+                float py1 = py0 + (float)(glyph->y1 - glyph->y0) * glyph_scale * inv_height;
+
+                float u0 = (float)glyph->x0 * inv_atlas_w;
+                float v0 = (float)glyph->y0 * inv_atlas_h;
+                float u1 = (float)glyph->x1 * inv_atlas_w;
+                float v1 = (float)glyph->y1 * inv_atlas_h;
+
+                const float quad[RGFX_TEXT_FLOATS_PER_GLYPH] = {
+                    px0, py0, u0, v0,
+                    px1, py0, u1, v0,
+                    px1, py1, u1, v1,
+                    px0, py1, u0, v1,
+                };
+
+                uint32_t index = text->glyph_count++;
+                float*   out   = text->vertices + (size_t)index * RGFX_TEXT_FLOATS_PER_GLYPH;
+                if (index >= previous_count || memcmp(out, quad, sizeof(quad)) != 0)
+                {
+                    memcpy(out, quad, sizeof(quad));
+                    dirty->first = index < dirty->first ? index : dirty->first;
+                    dirty->end   = index + 1u > dirty->end ? index + 1u : dirty->end;
+                }
             }
-        }
 
-        line_widths[i] = line_width;
-        if (line_width > total_width)
-        {
-            total_width = line_width;
+            int advance = rgfx_font_advance(metrics, codepoint);
+            if (next >= 0)
+            {
+                advance += rgfx_font_kerning(metrics, codepoint, next);
+            }
+            x += (float)advance * glyph_scale;
+
+            codepoint = next;
         }
+
+        y += line_height;
     }
+}
 
-    int total_height = lines.count * line_height + RGFX_TEXT_BITMAP_PADDING;
+/* Splits the text into line spans in the scratch arena and measures each one */
+static rgfx_text_line_t* rgfx_text_measure_lines(rgfx_text_t*         text,
+                                                 rgfx_font_metrics_t* metrics,
+                                                 uint32_t*            out_line_count)
+{
+    const char* begin = text->text;
+    const char* end   = text->text + text->text_length;
 
-    text->bitmap_width  = total_width + RGFX_TEXT_BITMAP_PADDING;
-    text->bitmap_height = total_height;
+    const float glyph_scale = rgfx_text_glyph_scale(text);
 
-    text->font_bitmap = (unsigned char*)calloc((size_t)text->bitmap_width * (size_t)text->bitmap_height, sizeof(unsigned char));
-    if (!text->font_bitmap)
+    uint32_t line_count = 1;
+    for (const char* p = begin; (p = memchr(p, '\n', (size_t)(end - p))) != NULL; ++p)
     {
-        free(line_widths);
-        rgfx_free_text_lines(&lines);
-        return false;
+        line_count++;
     }
 
-    int baseline = rounded_ascent;
-    int y        = baseline;
-
-    for (int line_index = 0; line_index < lines.count; ++line_index)
+    rgfx_text_line_t* lines = (rgfx_text_line_t*)rgfx_text_scratch(text, (size_t)line_count * sizeof(rgfx_text_line_t));
+    if (!lines)
     {
-        const char* line_text = lines.lines[line_index];
-        int         line_width = line_widths[line_index];
+        return NULL;
+    }
 
-        int x = RGFX_TEXT_BITMAP_PADDING / 2;
-        if (text->alignment == RGFX_TEXT_ALIGN_CENTER)
+    const char* start = begin;
+    for (uint32_t i = 0; i < line_count; ++i)
+    {
+        const char* line_end = memchr(start, '\n', (size_t)(end - start));
+        if (!line_end)
         {
-            x = (text->bitmap_width - line_width) / 2;
+            line_end = end;
         }
-        else if (text->alignment == RGFX_TEXT_ALIGN_RIGHT)
+
+        int         width     = 0;
+        const char* cursor    = start;
+        int         codepoint = cursor < line_end ? rgfx_utf8_next(&cursor, line_end) : -1;
+        while (codepoint >= 0)
         {
-            x = text->bitmap_width - line_width - RGFX_TEXT_BITMAP_PADDING / 2;
+            int next = cursor < line_end ? rgfx_utf8_next(&cursor, line_end) : -1;
+
+            width += rgfx_font_advance(metrics, codepoint);
+            if (next >= 0)
+            {
+                width += rgfx_font_kerning(metrics, codepoint, next);
+            }
+
+            codepoint = next;
         }
 
-        for (const char* p = line_text; *p; ++p)
-        {
-            int advance = 0;
-            int lsb     = 0;
-            stbtt_GetCodepointHMetrics(text->font_info, (int)*p, &advance, &lsb);
+        lines[i].start  = (uint32_t)(start - begin);
+        lines[i].length = (uint32_t)(line_end - start);
+        lines[i].width  = (float)width * glyph_scale;
 
-            int c_x1, c_y1, c_x2, c_y2;
-            stbtt_GetCodepointBitmapBox(text->font_info, (int)*p, scale, scale, &c_x1, &c_y1, &c_x2, &c_y2);
+        start = line_end + 1;
+    }
 
-            int width  = c_x2 - c_x1;
-            int height = c_y2 - c_y1;
+    *out_line_count = line_count;
+    return lines;
+}
 
-            unsigned char* bitmap = (unsigned char*)malloc((size_t)width * (size_t)height);
-            if (bitmap)
-            {
-                stbtt_MakeCodepointBitmap(text->font_info,
-                                          bitmap,
-                                          width,
-                                          height,
-                                          width,
-                                          scale,
-                                          scale,
-                                          (int)*p);
-
-                for (int row = 0; row < height; ++row)
-                {
-                    unsigned char* dst = text->font_bitmap + (size_t)(y + row + c_y1) * (size_t)text->bitmap_width + (size_t)(x + c_x1);
-                    unsigned char* src = bitmap + (size_t)row * (size_t)width;
-                    memcpy(dst, src, (size_t)width);
-                }
+static bool rgfx_text_update_bitmap_ptr(rgfx_text_t* text)
+{
+    if (!text || !text->font || !text->atlas || !text->text)
+    {
+        return false;
+    }
 
-                free(bitmap);
-            }
+    // Metrics come at the atlas height, so every SDF size shares one table and scales it
+    rgfx_font_metrics_t* metrics = rgfx_internal_font_metrics(text->font, text->atlas->pixel_height);
+    if (!metrics)
+    {
+        return false;
+    }
 
-            x += (int)(advance * scale + 0.5f);
-            if (*(p + 1))
-            {
-                int kern = stbtt_GetCodepointKernAdvance(text->font_info, (int)*p, (int)*(p + 1));
-                x += (int)(kern * scale + 0.5f);
-            }
+    float line_spacing = text->line_spacing > 0 ? text->line_spacing : 1.2f;
+    float line_height  = floorf(((float)(metrics->ascent - metrics->descent) * rgfx_text_glyph_scale(text) * line_spacing) + 0.5f);
+
+    uint32_t          line_count = 0;
+    rgfx_text_line_t* lines      = rgfx_text_measure_lines(text, metrics, &line_count);
+    if (!lines)
+    {
+        return false;
+    }
+
+    float total_width = 0.0f;
+    for (uint32_t i = 0; i < line_count; ++i)
+    {
+        if (lines[i].width > total_width)
+        {
+            total_width = lines[i].width;
         }
+    }
 
-        y += line_height;
+    text->layout_width  = (int)ceilf(total_width) + RGFX_TEXT_BITMAP_PADDING;
+    text->layout_height = (int)line_count * (int)line_height + RGFX_TEXT_BITMAP_PADDING;
+
+    // Every codepoint takes at least one byte, so the byte length bounds the glyph count
+    if (!rgfx_text_reserve_glyphs(text, text->text_length))
+    {
+        return false;
     }
 
-    rgfx_free_text_lines(&lines);
-    free(line_widths);
+    // A glyph rasterized mid-layout can grow the atlas; rebuild until every UV uses the final size
+    rgfx_text_dirty_t dirty = { UINT32_MAX, 0u };
+    uint32_t          generation;
+    do
+    {
+        generation = text->atlas->generation;
+        rgfx_text_build_quads(text, lines, line_count, metrics, line_height, &dirty);
+    } while (generation != text->atlas->generation);
+
+    text->atlas_generation = generation;
+
+    // Glyphs rasterized by this layout reach the texture in a single upload
+    rgfx_internal_glyph_atlas_flush(text->atlas);
 
-    if (!text->textureID)
+    rgfx_internal_bind_vertex_array(text->VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, text->VBO);
+
+    const size_t glyph_bytes = RGFX_TEXT_FLOATS_PER_GLYPH * sizeof(float);
+    if (text->glyph_count > text->vbo_capacity)
     {
-        glGenTextures(1, &text->textureID);
+        // Size the storage to the vertex array's capacity so the next few longer strings fit in place
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)((size_t)text->glyph_capacity * glyph_bytes), NULL, GL_DYNAMIC_DRAW);
+        text->vbo_capacity = text->glyph_capacity;
+        dirty.first        = 0u;
+        dirty.end          = text->glyph_count;
     }
 
-    glBindTexture(GL_TEXTURE_2D, text->textureID);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-#if defined(__EMSCRIPTEN__)
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, text->bitmap_width, text->bitmap_height, 0, GL_RED, GL_UNSIGNED_BYTE, text->font_bitmap);
-#else
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, text->bitmap_width, text->bitmap_height, 0, GL_RED, GL_UNSIGNED_BYTE, text->font_bitmap);
-#endif
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    if (dirty.end > text->glyph_count)
+    {
+        dirty.end = text->glyph_count;
+    }
+    if (dirty.first < dirty.end)
+    {
+        glBufferSubData(GL_ARRAY_BUFFER,
+                        (GLintptr)((size_t)dirty.first * glyph_bytes),
+                        (GLsizeiptr)((size_t)(dirty.end - dirty.first) * glyph_bytes),
+                        text->vertices + (size_t)dirty.first * RGFX_TEXT_FLOATS_PER_GLYPH);
+    }
 
-    text->index_count = 6;
+    unsigned int index_buffer = rgfx_internal_glyph_index_buffer(text->glyph_count);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer);
 
-    return true;
+    rgfx_internal_bind_vertex_array(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return index_buffer != 0;
 }
 
 bool rgfx_text_update_bitmap(rgfx_text_handle handle)
@@ -528,9 +740,16 @@ void rgfx_text_set_text(rgfx_text_handle handle, const char* new_text)
         return;
     }
 
-    strncpy(text->text, new_text, RGFX_MAX_TEXT_LENGTH - 1);
-    text->text[RGFX_MAX_TEXT_LENGTH - 1] = '\0';
-    rgfx_text_update_bitmap_ptr(text);
+    // Layout only depends on the string here, so an unchanged string has nothing to redo
+    if (strcmp(text->text, new_text) == 0)
+    {
+        return;
+    }
+
+    if (rgfx_text_assign(text, new_text))
+    {
+        rgfx_text_update_bitmap_ptr(text);
+    }
 }
 
 void rgfx_text_set_font_size(rgfx_text_handle handle, float size)
@@ -543,6 +762,17 @@ void rgfx_text_set_font_size(rgfx_text_handle handle, float size)
 
     text->font_size = size;
 
+    // A distance-field atlas already serves every size, so only bitmap text needs new glyphs
+    if (!text->sdf && text->font)
+    {
+        rgfx_glyph_atlas_t* atlas = rgfx_internal_glyph_atlas_acquire(text->font, size, false);
+        if (atlas)
+        {
+            rgfx_internal_glyph_atlas_release(text->atlas);
+            text->atlas = atlas;
+        }
+    }
+
     vec3 scale = { size * 0.04f, size * -0.04f, 1.0f };
     rtransform_set_scale(text->transform, scale);
     rgfx_text_update_bitmap_ptr(text);
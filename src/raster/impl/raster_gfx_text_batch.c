@@ -0,0 +1,275 @@
+#include "raster_gfx_internal.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RGFX_TEXT_BATCH_INITIAL_QUADS 1024u
+#define RGFX_TEXT_CORNER_FLOATS       4 /* text layout stores pos2 + uv2 per corner */
+
+typedef struct
+{
+    float position[3];
+    float texcoord[2];
+    float color[3];
+} rgfx_text_vertex_t;
+
+static struct
+{
+    unsigned int VAO;
+    unsigned int VBO;
+    uint32_t     buffer_quad_capacity;
+
+    unsigned int               programs[2]; /* bitmap, sdf */
+    const rgfx_program_info_t* program_infos[2];
+
+    rgfx_text_vertex_t*       vertices;
+    uint32_t                  quad_count;
+    uint32_t                  quad_capacity;
+    uint32_t                  text_count;
+    const rgfx_glyph_atlas_t* atlas;
+
+    bool active;
+} g_text_batch = { 0 };
+
+static bool rgfx_text_batch_ensure_gl_objects(void)
+{
+    if (g_text_batch.VAO)
+    {
+        return true;
+    }
+
+    glGenVertexArrays(1, &g_text_batch.VAO);
+    glGenBuffers(1, &g_text_batch.VBO);
+
+    if (!g_text_batch.VAO || !g_text_batch.VBO)
+    {
+        rlog_error("rgfx: failed to create text batch buffers");
+        rgfx_internal_text_batch_shutdown();
+        return false;
+    }
+
+    rgfx_internal_bind_vertex_array(g_text_batch.VAO);
+
+    g_text_batch.buffer_quad_capacity = RGFX_TEXT_BATCH_INITIAL_QUADS;
+    glBindBuffer(GL_ARRAY_BUFFER, g_text_batch.VBO);
+    glBufferData(GL_ARRAY_BUFFER,
+                 (GLsizeiptr)((size_t)g_text_batch.buffer_quad_capacity * 4u * sizeof(rgfx_text_vertex_t)),
+                 NULL,
+                 GL_STREAM_DRAW);
+
+    const GLsizei stride = (GLsizei)sizeof(rgfx_text_vertex_t);
+    glVertexAttribPointer(RGFX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(rgfx_text_vertex_t, position));
+    glEnableVertexAttribArray(RGFX_ATTRIB_POSITION);
+    glVertexAttribPointer(RGFX_ATTRIB_TEXCOORD, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(rgfx_text_vertex_t, texcoord));
+    glEnableVertexAttribArray(RGFX_ATTRIB_TEXCOORD);
+    glVertexAttribPointer(RGFX_ATTRIB_VERTEX_COLOR, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(rgfx_text_vertex_t, color));
+    glEnableVertexAttribArray(RGFX_ATTRIB_VERTEX_COLOR);
+
+    rgfx_internal_bind_vertex_array(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return true;
+}
+
+static unsigned int rgfx_text_batch_program(bool sdf, const rgfx_program_info_t** out_info)
+{
+    int variant = sdf ? 1 : 0;
+    if (!g_text_batch.programs[variant])
+    {
+        g_text_batch.programs[variant] =
+            rgfx_internal_acquire_shader_program(rgfx_internal_default_text_batch_vertex_shader(),
+                                                 rgfx_internal_default_text_batch_fragment_shader(sdf));
+        g_text_batch.program_infos[variant] = rgfx_internal_program_info(g_text_batch.programs[variant]);
+    }
+
+    *out_info = g_text_batch.program_infos[variant];
+    return g_text_batch.programs[variant];
+}
+
+static bool rgfx_text_batch_reserve(uint32_t quad_count)
+{
+    if (quad_count <= g_text_batch.quad_capacity)
+    {
+        return true;
+    }
+
+    uint32_t new_capacity = g_text_batch.quad_capacity ? g_text_batch.quad_capacity : RGFX_TEXT_BATCH_INITIAL_QUADS;
+    while (new_capacity < quad_count)
+    {
+        new_capacity *= 2u;
+    }
+
+    rgfx_text_vertex_t* vertices =
+        (rgfx_text_vertex_t*)realloc(g_text_batch.vertices, (size_t)new_capacity * 4u * sizeof(rgfx_text_vertex_t));
+    if (!vertices)
+    {
+        return false;
+    }
+
+    g_text_batch.vertices      = vertices;
+    g_text_batch.quad_capacity = new_capacity;
+    return true;
+}
+
+void rgfx_internal_text_batch_flush(void)
+{
+    uint32_t quad_count = g_text_batch.quad_count;
+    uint32_t text_count = g_text_batch.text_count;
+    if (quad_count == 0)
+    {
+        return;
+    }
+
+    const rgfx_glyph_atlas_t* atlas = g_text_batch.atlas;
+
+    g_text_batch.quad_count = 0;
+    g_text_batch.text_count = 0;
+    g_text_batch.atlas      = NULL;
+
+    if (!rgfx_text_batch_ensure_gl_objects())
+    {
+        return;
+    }
+
+    const rgfx_program_info_t* program      = NULL;
+    unsigned int               program_name = rgfx_text_batch_program(atlas->sdf, &program);
+    if (!program_name || !program)
+    {
+        return;
+    }
+
+    rgfx_internal_use_program(program_name);
+    rgfx_internal_program_upload_frame(program);
+
+    rgfx_internal_bind_texture(0, atlas->texture);
+    glUniform1i(program->slots[RGFX_UNIFORM_SLOT_TEXTURE], 0);
+
+    rgfx_internal_bind_vertex_array(g_text_batch.VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, g_text_batch.VBO);
+    while (g_text_batch.buffer_quad_capacity < quad_count)
+    {
+        g_text_batch.buffer_quad_capacity *= 2u;
+    }
+    // Orphan the previous storage so the driver does not stall on in-flight draws
+    glBufferData(GL_ARRAY_BUFFER,
+                 (GLsizeiptr)((size_t)g_text_batch.buffer_quad_capacity * 4u * sizeof(rgfx_text_vertex_t)),
+                 NULL,
+                 GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER,
+                    0,
+                    (GLsizeiptr)((size_t)quad_count * 4u * sizeof(rgfx_text_vertex_t)),
+                    g_text_batch.vertices);
+
+    // The element binding is VAO state, so the shared glyph index buffer is attached with our VAO bound
+    unsigned int index_buffer = rgfx_internal_glyph_index_buffer(quad_count);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer);
+    if (index_buffer)
+    {
+        glDrawElements(GL_TRIANGLES, (GLsizei)(quad_count * RGFX_QUAD_INDEX_COUNT), GL_UNSIGNED_INT, 0);
+        rgfx_internal_stats_count_draw(false);
+        rgfx_internal_stats_count_texts(text_count);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+bool rgfx_internal_text_batch_push(const rgfx_text_t* text)
+{
+    if (!g_text_batch.active)
+    {
+        return false;
+    }
+
+    if (!text || !text->atlas || text->glyph_count == 0)
+    {
+        return true;
+    }
+
+    // Sprites queued before this text must reach the screen first
+    rgfx_internal_batch_flush();
+
+    if (g_text_batch.atlas && g_text_batch.atlas != text->atlas)
+    {
+        rgfx_internal_text_batch_flush();
+    }
+
+    if (!rgfx_text_batch_reserve(g_text_batch.quad_count + text->glyph_count))
+    {
+        rlog_error("rgfx: failed to grow text batch");
+        return false;
+    }
+
+    mat4x4 world;
+    rtransform_get_world_matrix(text->transform, world);
+
+    float r = text->text_color.r;
+    float g = text->text_color.g;
+    float b = text->text_color.b;
+
+    const float*        local = text->vertices;
+    rgfx_text_vertex_t* out   = g_text_batch.vertices + (size_t)g_text_batch.quad_count * 4u;
+    for (uint32_t corner = 0; corner < text->glyph_count * 4u; ++corner)
+    {
+        float x = local[0];
+        float y = local[1];
+
+        out->position[0] = world[0][0] * x + world[1][0] * y + world[3][0];
+        out->position[1] = world[0][1] * x + world[1][1] * y + world[3][1];
+        out->position[2] = world[0][2] * x + world[1][2] * y + world[3][2];
+        out->texcoord[0] = local[2];
+        out->texcoord[1] = local[3];
+        out->color[0]    = r;
+        out->color[1]    = g;
+        out->color[2]    = b;
+
+        local += RGFX_TEXT_CORNER_FLOATS;
+        out++;
+    }
+
+    g_text_batch.atlas       = text->atlas;
+    g_text_batch.quad_count += text->glyph_count;
+    g_text_batch.text_count++;
+    return true;
+}
+
+void rgfx_internal_text_batch_begin(void)
+{
+    if (g_text_batch.active)
+    {
+        rgfx_internal_text_batch_flush();
+    }
+    g_text_batch.active = true;
+}
+
+void rgfx_internal_text_batch_end(void)
+{
+    g_text_batch.active = false;
+    rgfx_internal_text_batch_flush();
+}
+
+void rgfx_internal_text_batch_shutdown(void)
+{
+    if (g_text_batch.VAO)
+    {
+        rgfx_internal_state_forget_vertex_array(g_text_batch.VAO);
+        glDeleteVertexArrays(1, &g_text_batch.VAO);
+    }
+    if (g_text_batch.VBO)
+    {
+        glDeleteBuffers(1, &g_text_batch.VBO);
+    }
+
+    for (int variant = 0; variant < 2; ++variant)
+    {
+        if (g_text_batch.programs[variant])
+        {
+            rgfx_internal_release_shader_program(g_text_batch.programs[variant]);
+        }
+    }
+
+    free(g_text_batch.vertices);
+
+    memset(&g_text_batch, 0, sizeof(g_text_batch));
+}
@@ -0,0 +1,740 @@
+#include "raster_gfx_internal.h"
+#include "raster_gfx_rtex.h"
+#include "raster/raster_job.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb/stb_image.h>
+
+#define RGFX_MAX_TEXTURES        1024u
+#define RGFX_TEXTURE_INDEX_SLOTS (RGFX_MAX_TEXTURES * 2u)
+
+typedef struct
+{
+    char*        path;
+    uint32_t     path_hash;
+    unsigned int id;
+    int          width;
+    int          height;
+    int          channels;
+    size_t       bytes;
+    int          refcount;
+    bool         loading; /* showing the placeholder until its job completes */
+    bool         failed;  /* the async load failed, so the placeholder stays */
+} rgfx_texture_entry_t;
+
+typedef struct
+{
+    rgfx_texture_entry_t* object;
+    uint32_t              generation;
+} rgfx_texture_slot_t;
+
+/* CPU side of a texture load: a cooked mip chain (in place when packed) or decoded pixels.
+   Filled without touching GL, so it can run on a job worker. */
+typedef struct
+{
+    rasset_view_t      cooked;
+    rgfx_rtex_header_t header;
+    unsigned char*     pixels;
+    int                width;
+    int                height;
+    int                channels;
+} rgfx_texture_image_t;
+
+typedef struct
+{
+    const char* const*    paths;
+    rgfx_texture_image_t* images;
+    bool*                 loaded;
+} rgfx_texture_preload_t;
+
+typedef struct
+{
+    rgfx_texture_handle  handle;
+    char*                path;
+    rgfx_texture_image_t image;
+    bool                 ok;
+} rgfx_texture_job_t;
+
+static rgfx_texture_slot_t g_texture_slots[RGFX_MAX_TEXTURES];
+static uint32_t            g_texture_free_stack[RGFX_MAX_TEXTURES];
+static uint32_t            g_texture_free_top = 0;
+
+/* Open-addressed path index; each bucket holds a slot index + 1, 0 marks an empty bucket */
+static uint32_t g_texture_path_index[RGFX_TEXTURE_INDEX_SLOTS];
+
+static rgfx_texture_stats_t g_texture_stats;
+static bool                 g_texture_pool_initialized = false;
+
+static void rgfx_initialize_texture_pool(void)
+{
+    if (g_texture_pool_initialized)
+    {
+        return;
+    }
+
+    g_texture_free_top = 0;
+    for (uint32_t i = 0; i < RGFX_MAX_TEXTURES; ++i)
+    {
+        g_texture_slots[i].object     = NULL;
+        g_texture_slots[i].generation = 1u;
+        g_texture_free_stack[g_texture_free_top++] = (RGFX_MAX_TEXTURES - 1u) - i;
+    }
+
+    memset(g_texture_path_index, 0, sizeof(g_texture_path_index));
+    memset(&g_texture_stats, 0, sizeof(g_texture_stats));
+    g_texture_pool_initialized = true;
+}
+
+static uint32_t rgfx_hash_path(const char* path)
+{
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)path; *p; ++p)
+    {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void rgfx_texture_index_insert(uint32_t hash, uint32_t slot_index)
+{
+    uint32_t bucket = hash & (RGFX_TEXTURE_INDEX_SLOTS - 1u);
+    while (g_texture_path_index[bucket])
+    {
+        bucket = (bucket + 1u) & (RGFX_TEXTURE_INDEX_SLOTS - 1u);
+    }
+    g_texture_path_index[bucket] = slot_index + 1u;
+}
+
+static uint32_t rgfx_texture_index_find(const char* path, uint32_t hash)
+{
+    uint32_t bucket = hash & (RGFX_TEXTURE_INDEX_SLOTS - 1u);
+    while (g_texture_path_index[bucket])
+    {
+        const rgfx_texture_entry_t* entry = g_texture_slots[g_texture_path_index[bucket] - 1u].object;
+        if (entry && entry->path_hash == hash && strcmp(entry->path, path) == 0)
+        {
+            return bucket;
+        }
+        bucket = (bucket + 1u) & (RGFX_TEXTURE_INDEX_SLOTS - 1u);
+    }
+    return UINT32_MAX;
+}
+
+static void rgfx_texture_index_remove(uint32_t bucket)
+{
+    const uint32_t mask = RGFX_TEXTURE_INDEX_SLOTS - 1u;
+
+    g_texture_path_index[bucket] = 0;
+
+    // Re-seat the rest of the probe chain so later lookups do not stop at the hole
+    for (uint32_t next = (bucket + 1u) & mask; g_texture_path_index[next]; next = (next + 1u) & mask)
+    {
+        uint32_t slot_index        = g_texture_path_index[next] - 1u;
+        g_texture_path_index[next] = 0;
+        rgfx_texture_index_insert(g_texture_slots[slot_index].object->path_hash, slot_index);
+    }
+}
+
+static size_t rgfx_texture_mip_chain_bytes(int width, int height, int channels)
+{
+    size_t total = 0;
+    while (true)
+    {
+        total += (size_t)width * (size_t)height * (size_t)channels;
+        if (width == 1 && height == 1)
+        {
+            break;
+        }
+        width  = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return total;
+}
+
+unsigned char* rgfx_internal_load_image(const char* filepath, int* out_width, int* out_height, int* out_channels, int desired_channels)
+{
+    rasset_view_t file;
+    if (!rasset_open(filepath, &file))
+    {
+        return NULL;
+    }
+
+    // Per-thread flag: images are also decoded on job workers
+    stbi_set_flip_vertically_on_load_thread(1);
+    unsigned char* pixels =
+        stbi_load_from_memory(file.data, (int)file.size, out_width, out_height, out_channels, desired_channels);
+    rasset_close(&file);
+    return pixels;
+}
+
+void rgfx_internal_free_image(unsigned char* pixels)
+{
+    stbi_image_free(pixels);
+}
+
+static GLenum rgfx_texture_format(int channels)
+{
+    if (channels == 4)
+    {
+        return GL_RGBA;
+    }
+    if (channels == 1)
+    {
+        return GL_RED;
+    }
+    return GL_RGB;
+}
+
+static void rgfx_texture_set_parameters(void)
+{
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+/* "textures/a.png" -> "textures/a.rtex"; false when the result does not fit */
+static bool rgfx_texture_cooked_path(const char* filepath, char* out_path, size_t capacity)
+{
+    const char* slash     = strrchr(filepath, '/');
+    const char* extension = strrchr(filepath, '.');
+    size_t      stem      = (extension && (!slash || extension > slash)) ? (size_t)(extension - filepath) : strlen(filepath);
+
+    if (stem + sizeof(RGFX_RTEX_EXTENSION) > capacity)
+    {
+        return false;
+    }
+
+    memcpy(out_path, filepath, stem);
+    memcpy(out_path + stem, RGFX_RTEX_EXTENSION, sizeof(RGFX_RTEX_EXTENSION));
+    return true;
+}
+
+static bool rgfx_texture_validate_cooked(const rgfx_rtex_header_t* header, size_t file_size)
+{
+    if (header->magic != RGFX_RTEX_MAGIC || header->version != RGFX_RTEX_VERSION || header->width == 0 || header->height == 0 ||
+        header->level_count == 0 || header->level_count > RGFX_RTEX_MAX_LEVELS ||
+        header->level_count > rgfx_rtex_full_level_count(header->width, header->height) ||
+        (header->channels != 1 && header->channels != 3 && header->channels != 4) ||
+        (header->row_alignment != 1 && header->row_alignment != 4) || !(header->flags & RGFX_RTEX_FLAG_FLIPPED))
+    {
+        return false;
+    }
+
+    for (uint32_t level = 0; level < header->level_count; ++level)
+    {
+        uint32_t width  = rgfx_rtex_level_dimension(header->width, level);
+        uint32_t height = rgfx_rtex_level_dimension(header->height, level);
+        size_t   size   = (size_t)rgfx_rtex_row_pitch(width, header->channels, header->row_alignment) * height;
+        if (header->levels[level].size != size || (size_t)header->levels[level].offset + size > file_size)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Opens the .rtex next to filepath, in place from the asset pack or with one read.
+   Returns false without logging when there is no cooked file, so callers can fall back to decoding. */
+static bool rgfx_texture_read_cooked(const char* filepath, rgfx_texture_image_t* image)
+{
+    char cooked_path[512];
+    if (!rgfx_texture_cooked_path(filepath, cooked_path, sizeof(cooked_path)))
+    {
+        return false;
+    }
+
+    if (!rasset_open(cooked_path, &image->cooked))
+    {
+        return false;
+    }
+
+    if (image->cooked.size >= sizeof(image->header))
+    {
+        memcpy(&image->header, image->cooked.data, sizeof(image->header));
+    }
+    if (image->cooked.size < sizeof(image->header) || !rgfx_texture_validate_cooked(&image->header, image->cooked.size))
+    {
+        rlog_warning("rgfx: ignoring invalid cooked texture %s", cooked_path);
+        rasset_close(&image->cooked);
+        return false;
+    }
+
+    image->width    = (int)image->header.width;
+    image->height   = (int)image->header.height;
+    image->channels = (int)image->header.channels;
+    return true;
+}
+
+static bool rgfx_texture_read(const char* filepath, rgfx_texture_image_t* image)
+{
+    memset(image, 0, sizeof(*image));
+    if (rgfx_texture_read_cooked(filepath, image))
+    {
+        return true;
+    }
+
+    image->pixels = rgfx_internal_load_image(filepath, &image->width, &image->height, &image->channels, 0);
+    return image->pixels != NULL;
+}
+
+static void rgfx_texture_image_free(rgfx_texture_image_t* image)
+{
+    rasset_close(&image->cooked);
+    if (image->pixels)
+    {
+        rgfx_internal_free_image(image->pixels);
+    }
+    memset(image, 0, sizeof(*image));
+}
+
+static void rgfx_texture_upload(unsigned int textureID, const rgfx_texture_image_t* image)
+{
+    GLenum format = rgfx_texture_format(image->channels);
+    rgfx_internal_bind_texture(0, textureID);
+
+    if (image->pixels)
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, (GLint)format, image->width, image->height, 0, format, GL_UNSIGNED_BYTE, image->pixels);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        // Undo the single-level cap of a placeholder this texture may have started as
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000);
+    }
+    else
+    {
+        const rgfx_rtex_header_t* header = &image->header;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, (GLint)header->row_alignment);
+        for (uint32_t level = 0; level < header->level_count; ++level)
+        {
+            glTexImage2D(GL_TEXTURE_2D,
+                         (GLint)level,
+                         (GLint)format,
+                         (GLsizei)rgfx_rtex_level_dimension(header->width, level),
+                         (GLsizei)rgfx_rtex_level_dimension(header->height, level),
+                         0,
+                         format,
+                         GL_UNSIGNED_BYTE,
+                         image->cooked.data + header->levels[level].offset);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)header->level_count - 1);
+        g_texture_stats.cooked_loads++;
+    }
+
+    rgfx_texture_set_parameters();
+}
+
+static unsigned int rgfx_texture_load_file(const char* filepath, int* out_width, int* out_height, int* out_channels)
+{
+    rgfx_texture_image_t image;
+    if (!rgfx_texture_read(filepath, &image))
+    {
+        rlog_error("Failed to load texture: %s\n", filepath);
+        return 0;
+    }
+
+    unsigned int textureID = 0;
+    glGenTextures(1, &textureID);
+    rgfx_texture_upload(textureID, &image);
+
+    if (out_width)
+    {
+        *out_width = image.width;
+    }
+    if (out_height)
+    {
+        *out_height = image.height;
+    }
+    if (out_channels)
+    {
+        *out_channels = image.channels;
+    }
+
+    rgfx_texture_image_free(&image);
+    return textureID;
+}
+
+unsigned int rgfx_load_texture(const char* filepath)
+{
+    if (!filepath)
+    {
+        return 0;
+    }
+
+    return rgfx_texture_load_file(filepath, NULL, NULL, NULL);
+}
+
+static void rgfx_texture_preload_read(void* user, uint32_t index)
+{
+    rgfx_texture_preload_t* preload = (rgfx_texture_preload_t*)user;
+    preload->loaded[index] = preload->paths[index] && rgfx_texture_read(preload->paths[index], &preload->images[index]);
+}
+
+uint32_t rgfx_preload_textures(const char* const* paths, uint32_t count, unsigned int* out_ids)
+{
+    if (!paths || !out_ids || count == 0)
+    {
+        return 0;
+    }
+
+    rgfx_texture_preload_t preload;
+    preload.paths  = paths;
+    preload.images = (rgfx_texture_image_t*)calloc(count, sizeof(rgfx_texture_image_t));
+    preload.loaded = (bool*)calloc(count, sizeof(bool));
+
+    uint32_t loaded = 0;
+    if (!preload.images || !preload.loaded)
+    {
+        // No room to hold every image at once, so fall back to one at a time
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            out_ids[i] = paths[i] ? rgfx_texture_load_file(paths[i], NULL, NULL, NULL) : 0;
+            loaded += out_ids[i] != 0;
+        }
+    }
+    else
+    {
+        rjob_parallel_for(count, rgfx_texture_preload_read, &preload);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            out_ids[i] = 0;
+            if (!preload.loaded[i])
+            {
+                rlog_error("Failed to load texture: %s\n", paths[i] ? paths[i] : "(null)");
+                continue;
+            }
+
+            glGenTextures(1, &out_ids[i]);
+            rgfx_texture_upload(out_ids[i], &preload.images[i]);
+            rgfx_texture_image_free(&preload.images[i]);
+            loaded++;
+        }
+    }
+
+    free(preload.images);
+    free(preload.loaded);
+    return loaded;
+}
+
+void rgfx_delete_texture(unsigned int textureID)
+{
+    if (textureID)
+    {
+        rgfx_internal_state_forget_texture(textureID);
+        glDeleteTextures(1, &textureID);
+    }
+}
+
+static rgfx_texture_slot_t* rgfx_texture_slot(rgfx_texture_handle handle, uint32_t* out_index)
+{
+    if (handle == RGFX_INVALID_TEXTURE_HANDLE || !g_texture_pool_initialized)
+    {
+        return NULL;
+    }
+
+    uint32_t index = rgfx_handle_index(handle);
+    if (index >= RGFX_MAX_TEXTURES)
+    {
+        return NULL;
+    }
+
+    rgfx_texture_slot_t* slot = &g_texture_slots[index];
+    if (slot->object == NULL || slot->generation != rgfx_handle_generation(handle))
+    {
+        return NULL;
+    }
+
+    if (out_index)
+    {
+        *out_index = index;
+    }
+
+    return slot;
+}
+
+/* Runs on a job worker: no GL and no pool access, only the path copied at submit time */
+static void rgfx_texture_job_work(void* user)
+{
+    rgfx_texture_job_t* job = (rgfx_texture_job_t*)user;
+    job->ok                 = rgfx_texture_read(job->path, &job->image);
+}
+
+/* Replaces a placeholder entry's contents with a loaded image */
+static void rgfx_texture_adopt_image(rgfx_texture_entry_t* entry, const rgfx_texture_image_t* image)
+{
+    rgfx_texture_upload(entry->id, image);
+    entry->width    = image->width;
+    entry->height   = image->height;
+    entry->channels = image->channels;
+    entry->bytes    = rgfx_texture_mip_chain_bytes(entry->width, entry->height, entry->channels);
+    entry->loading  = false;
+    entry->failed   = false;
+    g_texture_stats.bytes_resident += entry->bytes;
+}
+
+static void rgfx_texture_mark_failed(rgfx_texture_entry_t* entry)
+{
+    // Keep the placeholder so sprites already using the handle still draw
+    rlog_error("Failed to load texture: %s\n", entry->path);
+    entry->loading = false;
+    entry->failed  = true;
+}
+
+static void rgfx_texture_job_complete(void* user)
+{
+    rgfx_texture_job_t*  job  = (rgfx_texture_job_t*)user;
+    rgfx_texture_slot_t* slot = rgfx_texture_slot(job->handle, NULL);
+
+    // Released while loading, or already loaded by a synchronous acquire: only the image is left to free
+    if (slot && slot->object->loading)
+    {
+        if (job->ok)
+        {
+            rgfx_texture_adopt_image(slot->object, &job->image);
+        }
+        else
+        {
+            rgfx_texture_mark_failed(slot->object);
+        }
+    }
+
+    if (job->ok)
+    {
+        rgfx_texture_image_free(&job->image);
+    }
+    free(job->path);
+    free(job);
+}
+
+/* 1x1 opaque white, so tinted sprites show their color until the image arrives */
+static void rgfx_texture_upload_placeholder(unsigned int textureID)
+{
+    static const unsigned char white[4] = { 255, 255, 255, 255 };
+
+    rgfx_internal_bind_texture(0, textureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    rgfx_texture_set_parameters();
+}
+
+static bool rgfx_texture_load_async(rgfx_texture_entry_t* entry, rgfx_texture_handle handle)
+{
+    rgfx_texture_job_t* job = (rgfx_texture_job_t*)calloc(1, sizeof(rgfx_texture_job_t));
+    if (!job)
+    {
+        return false;
+    }
+
+    job->handle = handle;
+    job->path   = (char*)malloc(strlen(entry->path) + 1);
+    if (!job->path)
+    {
+        free(job);
+        return false;
+    }
+    strcpy(job->path, entry->path);
+
+    glGenTextures(1, &entry->id);
+    rgfx_texture_upload_placeholder(entry->id);
+    entry->loading = true;
+
+    if (!rjob_submit(rgfx_texture_job_work, rgfx_texture_job_complete, job))
+    {
+        rgfx_internal_state_forget_texture(entry->id);
+        glDeleteTextures(1, &entry->id);
+        entry->id      = 0;
+        entry->loading = false;
+        free(job->path);
+        free(job);
+        return false;
+    }
+    return true;
+}
+
+static rgfx_texture_handle rgfx_texture_acquire_internal(const char* filepath, bool async)
+{
+    if (!filepath)
+    {
+        return RGFX_INVALID_TEXTURE_HANDLE;
+    }
+
+    rgfx_initialize_texture_pool();
+
+    uint32_t hash   = rgfx_hash_path(filepath);
+    uint32_t bucket = rgfx_texture_index_find(filepath, hash);
+    if (bucket != UINT32_MAX)
+    {
+        uint32_t              index = g_texture_path_index[bucket] - 1u;
+        rgfx_texture_slot_t*  slot  = &g_texture_slots[index];
+        rgfx_texture_entry_t* entry = slot->object;
+
+        // A blocking caller must not get a placeholder, so an unfinished async load is done here;
+        // its job still completes later and only frees its copy
+        if (!async && (entry->loading || entry->failed))
+        {
+            rgfx_texture_image_t image;
+            if (!rgfx_texture_read(entry->path, &image))
+            {
+                rgfx_texture_mark_failed(entry);
+                return RGFX_INVALID_TEXTURE_HANDLE;
+            }
+            rgfx_texture_adopt_image(entry, &image);
+            rgfx_texture_image_free(&image);
+        }
+
+        entry->refcount++;
+        g_texture_stats.hits++;
+        return rgfx_make_handle(index, slot->generation);
+    }
+
+    g_texture_stats.misses++;
+
+    if (g_texture_free_top == 0)
+    {
+        rlog_error("rgfx: texture pool exhausted (max %u)", (unsigned)RGFX_MAX_TEXTURES);
+        return RGFX_INVALID_TEXTURE_HANDLE;
+    }
+
+    rgfx_texture_entry_t* entry = (rgfx_texture_entry_t*)calloc(1, sizeof(rgfx_texture_entry_t));
+    if (!entry)
+    {
+        return RGFX_INVALID_TEXTURE_HANDLE;
+    }
+
+    entry->path = (char*)malloc(strlen(filepath) + 1);
+    if (!entry->path)
+    {
+        free(entry);
+        return RGFX_INVALID_TEXTURE_HANDLE;
+    }
+    strcpy(entry->path, filepath);
+
+    uint32_t            index  = g_texture_free_stack[g_texture_free_top - 1u];
+    rgfx_texture_handle handle = rgfx_make_handle(index, g_texture_slots[index].generation);
+
+    // The job only needs the handle, so the slot is claimed below whether loading now or later
+    if (!async || !rgfx_texture_load_async(entry, handle))
+    {
+        entry->id = rgfx_texture_load_file(filepath, &entry->width, &entry->height, &entry->channels);
+        if (!entry->id)
+        {
+            free(entry->path);
+            free(entry);
+            return RGFX_INVALID_TEXTURE_HANDLE;
+        }
+        entry->bytes = rgfx_texture_mip_chain_bytes(entry->width, entry->height, entry->channels);
+    }
+
+    entry->path_hash = hash;
+    entry->refcount  = 1;
+
+    --g_texture_free_top;
+    g_texture_slots[index].object = entry;
+    rgfx_texture_index_insert(hash, index);
+
+    g_texture_stats.textures_resident++;
+    g_texture_stats.bytes_resident += entry->bytes;
+
+    return handle;
+}
+
+rgfx_texture_handle rgfx_texture_acquire(const char* filepath)
+{
+    return rgfx_texture_acquire_internal(filepath, false);
+}
+
+rgfx_texture_handle rgfx_texture_acquire_async(const char* filepath)
+{
+    return rgfx_texture_acquire_internal(filepath, true);
+}
+
+bool rgfx_texture_is_ready(rgfx_texture_handle texture)
+{
+    rgfx_texture_slot_t* slot = rgfx_texture_slot(texture, NULL);
+    return slot ? !slot->object->loading && !slot->object->failed : false;
+}
+
+void rgfx_texture_release(rgfx_texture_handle texture)
+{
+    uint32_t             index = 0;
+    rgfx_texture_slot_t* slot  = rgfx_texture_slot(texture, &index);
+    if (!slot)
+    {
+        return;
+    }
+
+    rgfx_texture_entry_t* entry = slot->object;
+    if (--entry->refcount > 0)
+    {
+        return;
+    }
+
+    uint32_t bucket = rgfx_texture_index_find(entry->path, entry->path_hash);
+    if (bucket != UINT32_MAX)
+    {
+        rgfx_texture_index_remove(bucket);
+    }
+
+    g_texture_stats.textures_resident--;
+    g_texture_stats.bytes_resident -= entry->bytes;
+
+    rgfx_internal_state_forget_texture(entry->id);
+    glDeleteTextures(1, &entry->id);
+    free(entry->path);
+    free(entry);
+
+    slot->object     = NULL;
+    slot->generation = rgfx_next_generation(slot->generation);
+    g_texture_free_stack[g_texture_free_top++] = index;
+}
+
+unsigned int rgfx_texture_get_id(rgfx_texture_handle texture)
+{
+    rgfx_texture_slot_t* slot = rgfx_texture_slot(texture, NULL);
+    return slot ? slot->object->id : 0;
+}
+
+bool rgfx_internal_texture_has_alpha(rgfx_texture_handle texture)
+{
+    rgfx_texture_slot_t* slot = rgfx_texture_slot(texture, NULL);
+    return slot ? slot->object->channels == 4 : false;
+}
+
+void rgfx_texture_get_stats(rgfx_texture_stats_t* out_stats)
+{
+    if (!out_stats)
+    {
+        return;
+    }
+
+    rgfx_initialize_texture_pool();
+    *out_stats = g_texture_stats;
+}
+
+void rgfx_internal_texture_shutdown(void)
+{
+    if (!g_texture_pool_initialized)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < RGFX_MAX_TEXTURES; ++i)
+    {
+        rgfx_texture_entry_t* entry = g_texture_slots[i].object;
+        if (entry)
+        {
+            rgfx_internal_state_forget_texture(entry->id);
+            glDeleteTextures(1, &entry->id);
+            free(entry->path);
+            free(entry);
+            g_texture_slots[i].object = NULL;
+        }
+    }
+
+    g_texture_pool_initialized = false;
+}
@@ -0,0 +1,497 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "raster/raster_job.h"
+#include "raster/raster_log.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define RJOB_NO_THREADS
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define RJOB_MAX_THREADS 64u
+
+#if defined(RJOB_NO_THREADS)
+typedef int rjob_mutex_t;
+typedef int rjob_cond_t;
+typedef int rjob_thread_t;
+static void rjob_mutex_init(rjob_mutex_t* mutex) { (void)mutex; }
+static void rjob_mutex_destroy(rjob_mutex_t* mutex) { (void)mutex; }
+static void rjob_lock(rjob_mutex_t* mutex) { (void)mutex; }
+static void rjob_unlock(rjob_mutex_t* mutex) { (void)mutex; }
+static void rjob_cond_init(rjob_cond_t* cond) { (void)cond; }
+static void rjob_cond_destroy(rjob_cond_t* cond) { (void)cond; }
+static void rjob_cond_signal(rjob_cond_t* cond) { (void)cond; }
+static void rjob_cond_broadcast(rjob_cond_t* cond) { (void)cond; }
+#elif defined(_WIN32)
+typedef CRITICAL_SECTION   rjob_mutex_t;
+typedef CONDITION_VARIABLE rjob_cond_t;
+typedef HANDLE             rjob_thread_t;
+static void rjob_mutex_init(rjob_mutex_t* mutex) { InitializeCriticalSection(mutex); }
+static void rjob_mutex_destroy(rjob_mutex_t* mutex) { DeleteCriticalSection(mutex); }
+static void rjob_lock(rjob_mutex_t* mutex) { EnterCriticalSection(mutex); }
+static void rjob_unlock(rjob_mutex_t* mutex) { LeaveCriticalSection(mutex); }
+static void rjob_cond_init(rjob_cond_t* cond) { InitializeConditionVariable(cond); }
+static void rjob_cond_destroy(rjob_cond_t* cond) { (void)cond; }
+static void rjob_cond_wait(rjob_cond_t* cond, rjob_mutex_t* mutex) { SleepConditionVariableCS(cond, mutex, INFINITE); }
+static void rjob_cond_signal(rjob_cond_t* cond) { WakeConditionVariable(cond); }
+static void rjob_cond_broadcast(rjob_cond_t* cond) { WakeAllConditionVariable(cond); }
+#else
+typedef pthread_mutex_t rjob_mutex_t;
+typedef pthread_cond_t  rjob_cond_t;
+typedef pthread_t       rjob_thread_t;
+static void rjob_mutex_init(rjob_mutex_t* mutex) { pthread_mutex_init(mutex, NULL); }
+static void rjob_mutex_destroy(rjob_mutex_t* mutex) { pthread_mutex_destroy(mutex); }
+static void rjob_lock(rjob_mutex_t* mutex) { pthread_mutex_lock(mutex); }
+static void rjob_unlock(rjob_mutex_t* mutex) { pthread_mutex_unlock(mutex); }
+static void rjob_cond_init(rjob_cond_t* cond) { pthread_cond_init(cond, NULL); }
+static void rjob_cond_destroy(rjob_cond_t* cond) { pthread_cond_destroy(cond); }
+static void rjob_cond_wait(rjob_cond_t* cond, rjob_mutex_t* mutex) { pthread_cond_wait(cond, mutex); }
+static void rjob_cond_signal(rjob_cond_t* cond) { pthread_cond_signal(cond); }
+static void rjob_cond_broadcast(rjob_cond_t* cond) { pthread_cond_broadcast(cond); }
+#endif
+
+typedef struct rjob
+{
+    rjob_fn      work;
+    rjob_fn      complete;
+    void*        user;
+    struct rjob* next;
+} rjob_t;
+
+typedef struct
+{
+    rjob_t* head;
+    rjob_t* tail;
+} rjob_list_t;
+
+/* One rjob_parallel_for call; lives on the caller's stack until every helper has let go */
+typedef struct
+{
+    rjob_index_fn fn;
+    void*         user;
+    uint32_t      count;
+    uint32_t      next;    /* next index to hand out */
+    uint32_t      helpers; /* helper jobs submitted and not yet finished or withdrawn */
+} rjob_range_t;
+
+static struct
+{
+    rjob_mutex_t  mutex;
+    rjob_cond_t   work_ready; /* signalled when queued gains a job or the pool stops */
+    rjob_cond_t   range_done; /* signalled when a parallel-for helper finishes */
+    rjob_list_t   queued;     /* waiting for a worker */
+    rjob_list_t   finished;   /* work done, waiting for rjob_pump */
+    uint32_t      pending;
+    uint32_t      thread_count;
+    rjob_thread_t threads[RJOB_MAX_THREADS];
+    bool          stopping;
+    bool          initialized;
+} g_jobs;
+
+static void rjob_list_push(rjob_list_t* list, rjob_t* job)
+{
+    job->next = NULL;
+    if (list->tail)
+    {
+        list->tail->next = job;
+    }
+    else
+    {
+        list->head = job;
+    }
+    list->tail = job;
+}
+
+static rjob_t* rjob_list_pop(rjob_list_t* list)
+{
+    rjob_t* job = list->head;
+    if (job)
+    {
+        list->head = job->next;
+        if (!list->head)
+        {
+            list->tail = NULL;
+        }
+    }
+    return job;
+}
+
+static double rjob_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+#if !defined(RJOB_NO_THREADS)
+static void rjob_worker_loop(void)
+{
+    rjob_lock(&g_jobs.mutex);
+    while (true)
+    {
+        while (!g_jobs.queued.head && !g_jobs.stopping)
+        {
+            rjob_cond_wait(&g_jobs.work_ready, &g_jobs.mutex);
+        }
+
+        // Stopping still drains the queue so every job reaches its completion
+        rjob_t* job = rjob_list_pop(&g_jobs.queued);
+        if (!job)
+        {
+            break;
+        }
+
+        rjob_unlock(&g_jobs.mutex);
+        if (job->work)
+        {
+            job->work(job->user);
+        }
+        rjob_lock(&g_jobs.mutex);
+
+        // Nothing left for the main thread, so the job ends here instead of waiting for a pump
+        if (job->complete)
+        {
+            rjob_list_push(&g_jobs.finished, job);
+        }
+        else
+        {
+            free(job);
+            g_jobs.pending--;
+        }
+    }
+    rjob_unlock(&g_jobs.mutex);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI rjob_worker(LPVOID user)
+{
+    (void)user;
+    rjob_worker_loop();
+    return 0;
+}
+
+static bool rjob_thread_start(rjob_thread_t* thread)
+{
+    *thread = CreateThread(NULL, 0, rjob_worker, NULL, 0, NULL);
+    return *thread != NULL;
+}
+
+static void rjob_thread_join(rjob_thread_t thread)
+{
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+static uint32_t rjob_core_count(void)
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (uint32_t)info.dwNumberOfProcessors;
+}
+#else
+static void* rjob_worker(void* user)
+{
+    (void)user;
+    rjob_worker_loop();
+    return NULL;
+}
+
+static bool rjob_thread_start(rjob_thread_t* thread)
+{
+    return pthread_create(thread, NULL, rjob_worker, NULL) == 0;
+}
+
+static void rjob_thread_join(rjob_thread_t thread)
+{
+    pthread_join(thread, NULL);
+}
+
+static uint32_t rjob_core_count(void)
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (uint32_t)count : 1u;
+}
+#endif
+#endif
+
+bool rjob_init(uint32_t thread_count)
+{
+    if (g_jobs.initialized)
+    {
+        rjob_shutdown();
+    }
+
+    memset(&g_jobs, 0, sizeof(g_jobs));
+    rjob_mutex_init(&g_jobs.mutex);
+    rjob_cond_init(&g_jobs.work_ready);
+    rjob_cond_init(&g_jobs.range_done);
+    g_jobs.initialized = true;
+
+#if !defined(RJOB_NO_THREADS)
+    if (thread_count == RJOB_DEFAULT_THREADS)
+    {
+        uint32_t cores = rjob_core_count();
+        thread_count   = cores > 1u ? cores - 1u : 1u;
+    }
+    if (thread_count > RJOB_MAX_THREADS)
+    {
+        thread_count = RJOB_MAX_THREADS;
+    }
+
+    for (uint32_t i = 0; i < thread_count; ++i)
+    {
+        if (!rjob_thread_start(&g_jobs.threads[g_jobs.thread_count]))
+        {
+            rlog_warning("rjob: started %u of %u worker threads", g_jobs.thread_count, thread_count);
+            break;
+        }
+        g_jobs.thread_count++;
+    }
+#else
+    (void)thread_count;
+#endif
+
+    return true;
+}
+
+void rjob_shutdown(void)
+{
+    if (!g_jobs.initialized)
+    {
+        return;
+    }
+
+    rjob_lock(&g_jobs.mutex);
+    g_jobs.stopping = true;
+    rjob_cond_broadcast(&g_jobs.work_ready);
+    rjob_unlock(&g_jobs.mutex);
+
+#if !defined(RJOB_NO_THREADS)
+    for (uint32_t i = 0; i < g_jobs.thread_count; ++i)
+    {
+        rjob_thread_join(g_jobs.threads[i]);
+    }
+    g_jobs.thread_count = 0;
+#endif
+
+    // Workers are gone; whatever they did not reach runs here, then every completion
+    while (g_jobs.pending > 0)
+    {
+        rjob_pump(1e9);
+    }
+
+    rjob_cond_destroy(&g_jobs.work_ready);
+    rjob_cond_destroy(&g_jobs.range_done);
+    rjob_mutex_destroy(&g_jobs.mutex);
+    g_jobs.initialized = false;
+}
+
+uint32_t rjob_thread_count(void)
+{
+    return g_jobs.thread_count;
+}
+
+bool rjob_submit(rjob_fn work, rjob_fn complete, void* user)
+{
+    if (!g_jobs.initialized && !rjob_init(RJOB_DEFAULT_THREADS))
+    {
+        return false;
+    }
+
+    rjob_t* job = (rjob_t*)malloc(sizeof(rjob_t));
+    if (!job)
+    {
+        return false;
+    }
+
+    job->work     = work;
+    job->complete = complete;
+    job->user     = user;
+
+    rjob_lock(&g_jobs.mutex);
+    rjob_list_push(&g_jobs.queued, job);
+    g_jobs.pending++;
+    rjob_cond_signal(&g_jobs.work_ready);
+    rjob_unlock(&g_jobs.mutex);
+    return true;
+}
+
+uint32_t rjob_pump(double budget_seconds)
+{
+    if (!g_jobs.initialized)
+    {
+        return 0;
+    }
+
+    const double deadline = rjob_now() + budget_seconds;
+    uint32_t     ran      = 0;
+
+    do
+    {
+        rjob_lock(&g_jobs.mutex);
+        rjob_t* job = rjob_list_pop(&g_jobs.finished);
+        // No workers to hand the queue to (or they have exited): do the work here
+        if (!job && g_jobs.thread_count == 0)
+        {
+            job = rjob_list_pop(&g_jobs.queued);
+            if (job && job->work)
+            {
+                rjob_unlock(&g_jobs.mutex);
+                job->work(job->user);
+                rjob_lock(&g_jobs.mutex);
+            }
+        }
+        rjob_unlock(&g_jobs.mutex);
+
+        if (!job)
+        {
+            break;
+        }
+
+        if (job->complete)
+        {
+            job->complete(job->user);
+        }
+        free(job);
+
+        rjob_lock(&g_jobs.mutex);
+        g_jobs.pending--;
+        rjob_unlock(&g_jobs.mutex);
+        ran++;
+    } while (rjob_now() < deadline);
+
+    return ran;
+}
+
+uint32_t rjob_pending(void)
+{
+    if (!g_jobs.initialized)
+    {
+        return 0;
+    }
+
+    rjob_lock(&g_jobs.mutex);
+    uint32_t pending = g_jobs.pending;
+    rjob_unlock(&g_jobs.mutex);
+    return pending;
+}
+
+static void rjob_range_run(rjob_range_t* range)
+{
+    while (true)
+    {
+        rjob_lock(&g_jobs.mutex);
+        uint32_t index = range->next < range->count ? range->next++ : range->count;
+        rjob_unlock(&g_jobs.mutex);
+
+        if (index == range->count)
+        {
+            return;
+        }
+        range->fn(range->user, index);
+    }
+}
+
+#if !defined(RJOB_NO_THREADS)
+static void rjob_range_help(void* user)
+{
+    rjob_range_t* range = (rjob_range_t*)user;
+    rjob_range_run(range);
+
+    rjob_lock(&g_jobs.mutex);
+    range->helpers--;
+    rjob_cond_broadcast(&g_jobs.range_done);
+    rjob_unlock(&g_jobs.mutex);
+}
+
+/* Drops helpers no worker has picked up yet, so the caller does not wait behind unrelated jobs */
+static void rjob_range_withdraw(rjob_range_t* range)
+{
+    rjob_t* previous = NULL;
+    rjob_t* job      = g_jobs.queued.head;
+    while (job)
+    {
+        rjob_t* next = job->next;
+        if (job->work == rjob_range_help && job->user == range)
+        {
+            if (previous)
+            {
+                previous->next = next;
+            }
+            else
+            {
+                g_jobs.queued.head = next;
+            }
+            if (g_jobs.queued.tail == job)
+            {
+                g_jobs.queued.tail = previous;
+            }
+            free(job);
+            g_jobs.pending--;
+            range->helpers--;
+        }
+        else
+        {
+            previous = job;
+        }
+        job = next;
+    }
+}
+#endif
+
+void rjob_parallel_for(uint32_t count, rjob_index_fn fn, void* user)
+{
+    if (count == 0 || !fn)
+    {
+        return;
+    }
+
+    if (!g_jobs.initialized)
+    {
+        rjob_init(RJOB_DEFAULT_THREADS);
+    }
+
+    rjob_range_t range = { fn, user, count, 0, 0 };
+
+#if !defined(RJOB_NO_THREADS)
+    // The calling thread takes a share too, so one index needs no helper
+    uint32_t helpers = g_jobs.thread_count < count - 1u ? g_jobs.thread_count : count - 1u;
+    for (uint32_t i = 0; i < helpers; ++i)
+    {
+        rjob_lock(&g_jobs.mutex);
+        range.helpers++;
+        rjob_unlock(&g_jobs.mutex);
+
+        if (!rjob_submit(rjob_range_help, NULL, &range))
+        {
+            rjob_lock(&g_jobs.mutex);
+            range.helpers--;
+            rjob_unlock(&g_jobs.mutex);
+            break;
+        }
+    }
+#endif
+
+    rjob_range_run(&range);
+
+#if !defined(RJOB_NO_THREADS)
+    rjob_lock(&g_jobs.mutex);
+    rjob_range_withdraw(&range);
+    while (range.helpers > 0)
+    {
+        rjob_cond_wait(&g_jobs.range_done, &g_jobs.mutex);
+    }
+    rjob_unlock(&g_jobs.mutex);
+#endif
+}
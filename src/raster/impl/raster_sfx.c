@@ -1,6 +1,8 @@
 #define MINIAUDIO_IMPLEMENTATION
 #include "miniaudio/miniaudio.h"
 #include "raster/raster_sfx.h"
+#include "raster/raster_asset.h"
+#include "raster/raster_job.h"
 #include "raster/raster_log.h"
 #include <stddef.h>
 #include <stdlib.h>
@@ -15,8 +17,14 @@ typedef struct rsfx_sound
 {
     ma_decoder       decoder;
     ma_device        device;
+    rasset_view_t    file; // encoded bytes the decoder streams from; in place when packed
     int              loaded;
     int              loop;
+    int              loading;        // async load in flight; its job owns file and decoder until it completes
+    int              decoded;        // set by the job's worker
+    int              free_requested; // freed while loading, so the completion releases it
+    int              play_requested; // played while loading, so it starts once the device exists
+    float            volume;
     char*            path;
     rsfx_sound_handle handle;
     struct rsfx_sound* next; // cache linked list
@@ -225,23 +233,20 @@ bool rsfx_init(void)
     return true;
 }
 
-rsfx_sound_handle rsfx_load_sound(const char* path)
+static bool rsfx_sound_decode(rsfx_sound_t* sound)
 {
-    if (!g_sfx_initialized)
-        return RSFX_INVALID_SOUND_HANDLE;
-    rsfx_sound_t* cached = find_cached_sound(path);
-    if (cached)
-        return cached->handle;
-    rsfx_sound_t* sound = (rsfx_sound_t*)calloc(1, sizeof(rsfx_sound_t));
-    if (!sound)
-        return RSFX_INVALID_SOUND_HANDLE;
-    sound->path = strdup(path);
-    if (ma_decoder_init_file(path, NULL, &sound->decoder) != MA_SUCCESS)
+    if (!rasset_open(sound->path, &sound->file))
+        return false;
+    if (ma_decoder_init_memory(sound->file.data, sound->file.size, NULL, &sound->decoder) != MA_SUCCESS)
     {
-        free(sound->path);
-        free(sound);
-        return RSFX_INVALID_SOUND_HANDLE;
+        rasset_close(&sound->file);
+        return false;
     }
+    return true;
+}
+
+static bool rsfx_sound_init_device(rsfx_sound_t* sound)
+{
     ma_device_config deviceConfig  = ma_device_config_init(ma_device_type_playback);
     deviceConfig.playback.format   = sound->decoder.outputFormat;
     deviceConfig.playback.channels = sound->decoder.outputChannels;
@@ -251,39 +256,181 @@ rsfx_sound_handle rsfx_load_sound(const char* path)
     if (ma_device_init(NULL, &deviceConfig, &sound->device) != MA_SUCCESS)
     {
         ma_decoder_uninit(&sound->decoder);
+        rasset_close(&sound->file);
+        return false;
+    }
+    sound->loaded = 1;
+    return true;
+}
+
+// Worker side: file I/O and decoder setup only; nothing the main thread reads while loading
+static void rsfx_sound_job_work(void* user)
+{
+    rsfx_sound_t* sound = (rsfx_sound_t*)user;
+    sound->decoded      = rsfx_sound_decode(sound) ? 1 : 0;
+}
+
+static void rsfx_sound_job_complete(void* user)
+{
+    rsfx_sound_t* sound = (rsfx_sound_t*)user;
+    sound->loading      = 0;
+
+    if (sound->free_requested)
+    {
+        if (sound->decoded)
+        {
+            ma_decoder_uninit(&sound->decoder);
+            rasset_close(&sound->file);
+        }
+        free(sound->path);
+        free(sound);
+        return;
+    }
+
+    // A failed load leaves a valid handle that stays silent, like one whose device stopped
+    if (!sound->decoded || !rsfx_sound_init_device(sound))
+    {
+        rlog_error("rsfx: failed to load sound %s", sound->path);
+        return;
+    }
+
+    ma_device_set_master_volume(&sound->device, sound->volume);
+    if (sound->play_requested)
+    {
+        rsfx_play_sound(sound->handle, sound->loop != 0);
+    }
+}
+
+// Blocking load for a cached sound that is still loading or whose load failed. The worker may
+// still be writing the old object's decoder, so a fresh object is loaded and takes over its
+// handle and cache entry; an in-flight job then completes against the old one and frees it.
+static rsfx_sound_handle rsfx_sound_reload(rsfx_sound_t* stale)
+{
+    rsfx_sound_t* sound = (rsfx_sound_t*)calloc(1, sizeof(rsfx_sound_t));
+    if (!sound)
+        return RSFX_INVALID_SOUND_HANDLE;
+    sound->path = strdup(stale->path);
+    if (!sound->path || !rsfx_sound_decode(sound) || !rsfx_sound_init_device(sound))
+    {
+        rlog_error("rsfx: failed to load sound %s", stale->path);
         free(sound->path);
         free(sound);
         return RSFX_INVALID_SOUND_HANDLE;
     }
-    sound->loaded = 1;
+
+    rsfx_sound_slot_t* slot = rsfx_sound_slot_from_handle(stale->handle, NULL);
+    slot->object            = sound;
+    sound->handle           = stale->handle;
+    sound->loop             = stale->loop;
+    sound->volume           = stale->volume;
+    remove_sound_from_cache(stale);
     cache_sound(sound);
+
+    ma_device_set_master_volume(&sound->device, sound->volume);
+    if (stale->play_requested)
+    {
+        rsfx_play_sound(sound->handle, sound->loop != 0);
+    }
+
+    if (stale->loading)
+    {
+        stale->free_requested = 1;
+    }
+    else
+    {
+        free(stale->path);
+        free(stale);
+    }
+    return sound->handle;
+}
+
+static rsfx_sound_handle rsfx_load_sound_internal(const char* path, bool async)
+{
+    if (!g_sfx_initialized)
+        return RSFX_INVALID_SOUND_HANDLE;
+    rsfx_sound_t* cached = find_cached_sound(path);
+    // A blocking caller must get a sound that plays, not one still loading or already failed
+    if (cached && !async && !cached->loaded)
+        return rsfx_sound_reload(cached);
+    if (cached)
+        return cached->handle;
+    rsfx_sound_t* sound = (rsfx_sound_t*)calloc(1, sizeof(rsfx_sound_t));
+    if (!sound)
+        return RSFX_INVALID_SOUND_HANDLE;
+    sound->path   = strdup(path);
+    sound->volume = 1.0f;
+    if (async)
+    {
+        sound->loading = 1;
+    }
+    else if (!rsfx_sound_decode(sound) || !rsfx_sound_init_device(sound))
+    {
+        free(sound->path);
+        free(sound);
+        return RSFX_INVALID_SOUND_HANDLE;
+    }
     rsfx_sound_handle handle = rsfx_sound_register(sound);
     if (handle == RSFX_INVALID_SOUND_HANDLE)
     {
-        ma_device_uninit(&sound->device);
-        ma_decoder_uninit(&sound->decoder);
+        if (sound->loaded)
+        {
+            ma_device_uninit(&sound->device);
+            ma_decoder_uninit(&sound->decoder);
+            rasset_close(&sound->file);
+        }
         free(sound->path);
         free(sound);
         return RSFX_INVALID_SOUND_HANDLE;
     }
+    cache_sound(sound);
+
+    if (async && !rjob_submit(rsfx_sound_job_work, rsfx_sound_job_complete, sound))
+    {
+        // Nothing could be queued, so load now rather than hand back a handle that never loads
+        rsfx_sound_job_work(sound);
+        rsfx_sound_job_complete(sound);
+    }
 
     return handle;
 }
 
+rsfx_sound_handle rsfx_load_sound(const char* path)
+{
+    return rsfx_load_sound_internal(path, false);
+}
+
+rsfx_sound_handle rsfx_load_sound_async(const char* path)
+{
+    return rsfx_load_sound_internal(path, true);
+}
+
+bool rsfx_is_sound_ready(rsfx_sound_handle handle)
+{
+    rsfx_sound_t* sound = rsfx_sound_from_handle(handle);
+    return sound && sound->loaded;
+}
+
 void rsfx_free_sound(rsfx_sound_handle handle)
 {
     rsfx_sound_t* sound = rsfx_sound_from_handle(handle);
     if (!sound)
         return;
+    remove_sound_from_cache(sound);
+    rsfx_sound_unregister(handle);
+    // The worker may still be using the decoder; the job's completion frees the rest
+    if (sound->loading)
+    {
+        sound->free_requested = 1;
+        return;
+    }
     if (sound->loaded)
     {
         ma_device_uninit(&sound->device);
         ma_decoder_uninit(&sound->decoder);
     }
+    rasset_close(&sound->file);
     if (sound->path)
         free(sound->path);
-    remove_sound_from_cache(sound);
-    rsfx_sound_unregister(handle);
     free(sound);
 }
 
@@ -310,9 +457,16 @@ void rsfx_terminate(void)
 bool rsfx_play_sound(rsfx_sound_handle handle, bool loop)
 {
     rsfx_sound_t* sound = rsfx_sound_from_handle(handle);
-    if (!sound || !sound->loaded)
+    if (!sound)
         return false;
     sound->loop = loop ? 1 : 0;
+    if (sound->loading)
+    {
+        sound->play_requested = 1;
+        return true;
+    }
+    if (!sound->loaded)
+        return false;
     ma_decoder_seek_to_pcm_frame(&sound->decoder, 0);
     ma_device_stop(&sound->device); // Ensure stopped before starting
     return ma_device_start(&sound->device) == MA_SUCCESS;
@@ -321,7 +475,10 @@ bool rsfx_play_sound(rsfx_sound_handle handle, bool loop)
 void rsfx_stop_sound(rsfx_sound_handle handle)
 {
     rsfx_sound_t* sound = rsfx_sound_from_handle(handle);
-    if (!sound || !sound->loaded)
+    if (!sound)
+        return;
+    sound->play_requested = 0;
+    if (!sound->loaded)
         return;
     ma_device_stop(&sound->device);
 }
@@ -329,7 +486,10 @@ void rsfx_stop_sound(rsfx_sound_handle handle)
 void rsfx_set_volume(rsfx_sound_handle handle, float volume)
 {
     rsfx_sound_t* sound = rsfx_sound_from_handle(handle);
-    if (!sound || !sound->loaded)
+    if (!sound)
+        return;
+    sound->volume = volume;
+    if (!sound->loaded)
         return;
     ma_device_set_master_volume(&sound->device, volume);
 }
@@ -1,108 +1,498 @@
 #include "raster/raster_transform.h"
+#include "raster/raster_log.h"
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#define RTRANSFORM_NONE             UINT32_MAX
+#define RTRANSFORM_INITIAL_CAPACITY 256u
+#define RTRANSFORM_HANDLE_CHUNK     256u
+#define RTRANSFORM_UPDATE_BLOCK     64u
+
+#define RTRANSFORM_LOCAL_DIRTY 0x1u
+#define RTRANSFORM_WORLD_DIRTY 0x2u
+
+// Handles are stable slab entries pointing at the transform's current slot in the pool
+struct rtransform {
+    uint32_t index;
+    struct rtransform* next_free;
+};
+
+// Slots are kept in topological order (parent slot < child slot) so one forward pass
+// updates the whole hierarchy. A world matrix is stale when its own local data changed or
+// its parent's world was recomputed since it was last derived (version mismatch).
+static struct {
+    vec3* positions;
+    vec3* scales;
+    quat* rotations;
+    mat4x4* locals;
+    mat4x4* worlds;
+    uint32_t* parents;
+    uint32_t* versions;
+    uint32_t* parent_versions;
+    uint32_t* child_counts;
+    uint8_t* flags;
+    rtransform_t** owners;
+    uint32_t count;
+    uint32_t capacity;
+    bool needs_sort;
+
+    void* scratch;
+
+    rtransform_t** chunks;
+    uint32_t chunk_count;
+    uint32_t chunk_capacity;
+    rtransform_t* free_list;
+} g_transforms = { 0 };
+
+static bool rtransform_grow_array(void** array, size_t element_size, uint32_t capacity) {
+    void* grown = realloc(*array, element_size * capacity);
+    if (!grown) return false;
+    *array = grown;
+    return true;
+}
+
+static bool rtransform_pool_reserve(uint32_t count) {
+    if (count <= g_transforms.capacity) return true;
+
+    uint32_t capacity = g_transforms.capacity ? g_transforms.capacity : RTRANSFORM_INITIAL_CAPACITY;
+    while (capacity < count) {
+        capacity *= 2u;
+    }
+
+    if (!rtransform_grow_array((void**)&g_transforms.positions, sizeof(vec3), capacity) ||
+        !rtransform_grow_array((void**)&g_transforms.scales, sizeof(vec3), capacity) ||
+        !rtransform_grow_array((void**)&g_transforms.rotations, sizeof(quat), capacity) ||
+        !rtransform_grow_array((void**)&g_transforms.locals, sizeof(mat4x4), capacity) ||
+        !rtransform_grow_array((void**)&g_transforms.worlds, sizeof(mat4x4), capacity) ||
+        !rtransform_grow_array((void**)&g_transforms.parents, sizeof(uint32_t), capacity) ||
+        !rtransform_grow_array((void**)&g_transforms.versions, sizeof(uint32_t), capacity) ||
+        !rtransform_grow_array((void**)&g_transforms.parent_versions, sizeof(uint32_t), capacity) ||
+        !rtransform_grow_array((void**)&g_transforms.child_counts, sizeof(uint32_t), capacity) ||
+        !rtransform_grow_array((void**)&g_transforms.flags, sizeof(uint8_t), capacity) ||
+        !rtransform_grow_array((void**)&g_transforms.owners, sizeof(rtransform_t*), capacity) ||
+        !rtransform_grow_array(&g_transforms.scratch, sizeof(mat4x4), capacity)) {
+        return false;
+    }
+
+    g_transforms.capacity = capacity;
+    return true;
+}
+
+static rtransform_t* rtransform_handle_alloc(void) {
+    if (!g_transforms.free_list) {
+        if (g_transforms.chunk_count == g_transforms.chunk_capacity) {
+            uint32_t capacity = g_transforms.chunk_capacity ? g_transforms.chunk_capacity * 2u : 8u;
+            if (!rtransform_grow_array((void**)&g_transforms.chunks, sizeof(rtransform_t*), capacity)) return NULL;
+            g_transforms.chunk_capacity = capacity;
+        }
+
+        rtransform_t* chunk = (rtransform_t*)malloc(sizeof(rtransform_t) * RTRANSFORM_HANDLE_CHUNK);
+        if (!chunk) return NULL;
+        g_transforms.chunks[g_transforms.chunk_count++] = chunk;
+
+        for (uint32_t i = RTRANSFORM_HANDLE_CHUNK; i > 0; --i) {
+            chunk[i - 1].index = RTRANSFORM_NONE;
+            chunk[i - 1].next_free = g_transforms.free_list;
+            g_transforms.free_list = &chunk[i - 1];
+        }
+    }
+
+    rtransform_t* handle = g_transforms.free_list;
+    g_transforms.free_list = handle->next_free;
+    handle->next_free = NULL;
+    return handle;
+}
+
+static bool rtransform_is_stale(uint32_t index) {
+    uint32_t parent = g_transforms.parents[index];
+    return g_transforms.flags[index] ||
+           (parent != RTRANSFORM_NONE && g_transforms.parent_versions[index] != g_transforms.versions[parent]);
+}
+
+static void rtransform_compute(uint32_t index) {
+    if (g_transforms.flags[index] & RTRANSFORM_LOCAL_DIRTY) {
+        mat4x4_compose_trs(g_transforms.locals[index],
+                           g_transforms.positions[index],
+                           g_transforms.rotations[index],
+                           g_transforms.scales[index]);
+    }
+
+    uint32_t parent = g_transforms.parents[index];
+    if (parent != RTRANSFORM_NONE) {
+        mat4x4_mul_affine(g_transforms.worlds[index], g_transforms.worlds[parent], g_transforms.locals[index]);
+        g_transforms.parent_versions[index] = g_transforms.versions[parent];
+    } else {
+        mat4x4_dup(g_transforms.worlds[index], g_transforms.locals[index]);
+    }
+
+    g_transforms.flags[index] = 0;
+    g_transforms.versions[index]++;
+}
+
+static void rtransform_resolve(uint32_t index) {
+    uint32_t parent = g_transforms.parents[index];
+    if (parent != RTRANSFORM_NONE) {
+        rtransform_resolve(parent);
+    }
+    if (rtransform_is_stale(index)) {
+        rtransform_compute(index);
+    }
+}
+
+static void rtransform_move_slot(uint32_t to, uint32_t from) {
+    vec3_dup(g_transforms.positions[to], g_transforms.positions[from]);
+    vec3_dup(g_transforms.scales[to], g_transforms.scales[from]);
+    memcpy(g_transforms.rotations[to], g_transforms.rotations[from], sizeof(quat));
+    mat4x4_dup(g_transforms.locals[to], g_transforms.locals[from]);
+    mat4x4_dup(g_transforms.worlds[to], g_transforms.worlds[from]);
+    g_transforms.parents[to] = g_transforms.parents[from];
+    g_transforms.versions[to] = g_transforms.versions[from];
+    g_transforms.parent_versions[to] = g_transforms.parent_versions[from];
+    g_transforms.child_counts[to] = g_transforms.child_counts[from];
+    g_transforms.flags[to] = g_transforms.flags[from];
+    g_transforms.owners[to] = g_transforms.owners[from];
+    g_transforms.owners[to]->index = to;
+}
+
+static void rtransform_reparent_children(uint32_t from, uint32_t to) {
+    uint32_t remaining = g_transforms.child_counts[from];
+    for (uint32_t i = 0; i < g_transforms.count && remaining > 0; ++i) {
+        if (g_transforms.parents[i] == from) {
+            g_transforms.parents[i] = to;
+            if (to == RTRANSFORM_NONE) g_transforms.flags[i] |= RTRANSFORM_WORLD_DIRTY;
+            remaining--;
+        }
+    }
+}
+
+static void rtransform_permute(void* array, size_t element_size, const uint32_t* new_to_old) {
+    uint32_t count = g_transforms.count;
+    char* source = (char*)array;
+    char* sorted = (char*)g_transforms.scratch;
+    for (uint32_t i = 0; i < count; ++i) {
+        memcpy(sorted + i * element_size, source + new_to_old[i] * element_size, element_size);
+    }
+    memcpy(source, sorted, count * element_size);
+}
+
+// Re-establishes parent-before-child order by sorting slots on hierarchy depth
+static bool rtransform_sort(void) {
+    uint32_t count = g_transforms.count;
+    uint32_t* depths = (uint32_t*)calloc((size_t)count * 3u + 1u, sizeof(uint32_t));
+    if (!depths) return false;
+    uint32_t* new_to_old = depths + count;
+    uint32_t* old_to_new = new_to_old + count;
+
+    uint32_t max_depth = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        depths[i] = RTRANSFORM_NONE;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        // Walk up to the first ancestor with a known depth, then fill the path back down
+        uint32_t steps = 0;
+        uint32_t node = i;
+        while (depths[node] == RTRANSFORM_NONE && g_transforms.parents[node] != RTRANSFORM_NONE) {
+            node = g_transforms.parents[node];
+            steps++;
+        }
+        if (depths[node] == RTRANSFORM_NONE) depths[node] = 0;
+
+        uint32_t depth = depths[node] + steps;
+        for (node = i; depths[node] == RTRANSFORM_NONE; node = g_transforms.parents[node]) {
+            depths[node] = depth--;
+        }
+        if (depths[i] > max_depth) max_depth = depths[i];
+    }
+
+    // Counting sort keeps the existing order within each depth
+    uint32_t* offsets = (uint32_t*)calloc((size_t)max_depth + 2u, sizeof(uint32_t));
+    if (!offsets) {
+        free(depths);
+        return false;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        offsets[depths[i] + 1]++;
+    }
+    for (uint32_t d = 0; d <= max_depth; ++d) {
+        offsets[d + 1] += offsets[d];
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t slot = offsets[depths[i]]++;
+        new_to_old[slot] = i;
+        old_to_new[i] = slot;
+    }
+    free(offsets);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (g_transforms.parents[i] != RTRANSFORM_NONE) {
+            g_transforms.parents[i] = old_to_new[g_transforms.parents[i]];
+        }
+    }
+
+    rtransform_permute(g_transforms.positions, sizeof(vec3), new_to_old);
+    rtransform_permute(g_transforms.scales, sizeof(vec3), new_to_old);
+    rtransform_permute(g_transforms.rotations, sizeof(quat), new_to_old);
+    rtransform_permute(g_transforms.locals, sizeof(mat4x4), new_to_old);
+    rtransform_permute(g_transforms.worlds, sizeof(mat4x4), new_to_old);
+    rtransform_permute(g_transforms.parents, sizeof(uint32_t), new_to_old);
+    rtransform_permute(g_transforms.versions, sizeof(uint32_t), new_to_old);
+    rtransform_permute(g_transforms.parent_versions, sizeof(uint32_t), new_to_old);
+    rtransform_permute(g_transforms.child_counts, sizeof(uint32_t), new_to_old);
+    rtransform_permute(g_transforms.flags, sizeof(uint8_t), new_to_old);
+    rtransform_permute(g_transforms.owners, sizeof(rtransform_t*), new_to_old);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        g_transforms.owners[i]->index = i;
+    }
+
+    free(depths);
+    return true;
+}
 
 rtransform_t* rtransform_create(void) {
-    rtransform_t* transform = (rtransform_t*)malloc(sizeof(rtransform_t));
+    if (!rtransform_pool_reserve(g_transforms.count + 1u)) {
+        rlog_error("rtransform: failed to grow transform pool");
+        return NULL;
+    }
+
+    rtransform_t* transform = rtransform_handle_alloc();
     if (!transform) return NULL;
 
-    transform->position[0] = 0.0f;
-    transform->position[1] = 0.0f;
-    transform->position[2] = 0.0f;
+    uint32_t index = g_transforms.count++;
+    transform->index = index;
 
-    transform->scale[0] = 1.0f;
-    transform->scale[1] = 1.0f;
-    transform->scale[2] = 1.0f;
+    g_transforms.positions[index][0] = 0.0f;
+    g_transforms.positions[index][1] = 0.0f;
+    g_transforms.positions[index][2] = 0.0f;
+
+    g_transforms.scales[index][0] = 1.0f;
+    g_transforms.scales[index][1] = 1.0f;
+    g_transforms.scales[index][2] = 1.0f;
 
     // Initialize quaternion to identity rotation
-    quat_identity(transform->rotation);
-    transform->parent = NULL;
+    quat_identity(g_transforms.rotations[index]);
+
+    mat4x4_identity(g_transforms.locals[index]);
+    mat4x4_identity(g_transforms.worlds[index]);
 
-    mat4x4_identity(transform->local);
-    mat4x4_identity(transform->world);
+    g_transforms.parents[index] = RTRANSFORM_NONE;
+    g_transforms.versions[index] = 0;
+    g_transforms.parent_versions[index] = 0;
+    g_transforms.child_counts[index] = 0;
+    g_transforms.flags[index] = 0;
+    g_transforms.owners[index] = transform;
 
     return transform;
 }
 
 void rtransform_destroy(rtransform_t* transform) {
-    if (transform) {
-        free(transform);
+    if (!transform || transform->index == RTRANSFORM_NONE) return;
+
+    uint32_t index = transform->index;
+
+    // Children are detached rather than left pointing at a dead slot
+    if (g_transforms.child_counts[index] > 0) {
+        rtransform_reparent_children(index, RTRANSFORM_NONE);
     }
+    if (g_transforms.parents[index] != RTRANSFORM_NONE) {
+        g_transforms.child_counts[g_transforms.parents[index]]--;
+        g_transforms.parents[index] = RTRANSFORM_NONE;
+    }
+
+    uint32_t last = --g_transforms.count;
+    if (index != last) {
+        if (g_transforms.child_counts[last] > 0) {
+            rtransform_reparent_children(last, index);
+        }
+        rtransform_move_slot(index, last);
+
+        // The moved slot may now sit before its parent or after its children
+        if (g_transforms.parents[index] != RTRANSFORM_NONE || g_transforms.child_counts[index] > 0) {
+            g_transforms.needs_sort = true;
+        }
+    }
+
+    transform->index = RTRANSFORM_NONE;
+    transform->next_free = g_transforms.free_list;
+    g_transforms.free_list = transform;
 }
 
 void rtransform_set_parent(rtransform_t* transform, rtransform_t* parent) {
-    if (transform) {
-        transform->parent = parent;
-        rtransform_update(transform);
+    if (!transform || transform->index == RTRANSFORM_NONE) return;
+
+    uint32_t index = transform->index;
+    uint32_t parent_index = (parent && parent->index != RTRANSFORM_NONE) ? parent->index : RTRANSFORM_NONE;
+
+    for (uint32_t ancestor = parent_index; ancestor != RTRANSFORM_NONE; ancestor = g_transforms.parents[ancestor]) {
+        if (ancestor == index) {
+            rlog_error("rtransform: parenting would create a cycle");
+            return;
+        }
+    }
+
+    if (g_transforms.parents[index] != RTRANSFORM_NONE) {
+        g_transforms.child_counts[g_transforms.parents[index]]--;
+    }
+    g_transforms.parents[index] = parent_index;
+    g_transforms.flags[index] |= RTRANSFORM_WORLD_DIRTY;
+
+    if (parent_index != RTRANSFORM_NONE) {
+        g_transforms.child_counts[parent_index]++;
+        if (parent_index > index) g_transforms.needs_sort = true;
     }
 }
 
 void rtransform_set_position(rtransform_t* transform, vec3 position) {
-    if (transform) {
-        vec3_dup(transform->position, position);
-        rtransform_update(transform);
+    if (transform && transform->index != RTRANSFORM_NONE) {
+        vec3_dup(g_transforms.positions[transform->index], position);
+        g_transforms.flags[transform->index] |= RTRANSFORM_LOCAL_DIRTY;
     }
 }
 
 void rtransform_set_scale(rtransform_t* transform, vec3 scale) {
-    if (transform) {
-        vec3_dup(transform->scale, scale);
-        rtransform_update(transform);
+    if (transform && transform->index != RTRANSFORM_NONE) {
+        vec3_dup(g_transforms.scales[transform->index], scale);
+        g_transforms.flags[transform->index] |= RTRANSFORM_LOCAL_DIRTY;
     }
 }
 
 void rtransform_set_rotation_axis_angle(rtransform_t* transform, vec3 axis, float angle) {
-    if (transform) {
-        quat_rotate(transform->rotation, angle, axis);
-        rtransform_update(transform);
+    if (transform && transform->index != RTRANSFORM_NONE) {
+        quat_rotate(g_transforms.rotations[transform->index], angle, axis);
+        g_transforms.flags[transform->index] |= RTRANSFORM_LOCAL_DIRTY;
     }
 }
 
 void rtransform_set_rotation_quat(rtransform_t* transform, quat rotation) {
-    if (transform) {
-        memcpy(transform->rotation, rotation, sizeof(quat));
-        rtransform_update(transform);
+    if (transform && transform->index != RTRANSFORM_NONE) {
+        memcpy(g_transforms.rotations[transform->index], rotation, sizeof(quat));
+        g_transforms.flags[transform->index] |= RTRANSFORM_LOCAL_DIRTY;
+    }
+}
+
+void rtransform_set_positions(rtransform_t* const* transforms, const float* positions, uint32_t count) {
+    if (!transforms || !positions) return;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const rtransform_t* transform = transforms[i];
+        if (!transform || transform->index == RTRANSFORM_NONE) continue;
+
+        uint32_t index = transform->index;
+        g_transforms.positions[index][0] = positions[i * 3 + 0];
+        g_transforms.positions[index][1] = positions[i * 3 + 1];
+        g_transforms.positions[index][2] = positions[i * 3 + 2];
+        g_transforms.flags[index] |= RTRANSFORM_LOCAL_DIRTY;
+    }
+}
+
+void rtransform_set_rotations_quat(rtransform_t* const* transforms, const float* rotations, uint32_t count) {
+    if (!transforms || !rotations) return;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const rtransform_t* transform = transforms[i];
+        if (!transform || transform->index == RTRANSFORM_NONE) continue;
+
+        memcpy(g_transforms.rotations[transform->index], rotations + i * 4, sizeof(quat));
+        g_transforms.flags[transform->index] |= RTRANSFORM_LOCAL_DIRTY;
+    }
+}
+
+void rtransform_set_rotations_z(rtransform_t* const* transforms, const float* angles, uint32_t count) {
+    if (!transforms || !angles) return;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const rtransform_t* transform = transforms[i];
+        if (!transform || transform->index == RTRANSFORM_NONE) continue;
+
+        // Same quaternion quat_rotate builds for the unit Z axis
+        uint32_t index = transform->index;
+        g_transforms.rotations[index][0] = 0.0f;
+        g_transforms.rotations[index][1] = 0.0f;
+        g_transforms.rotations[index][2] = sinf(angles[i] * 0.5f);
+        g_transforms.rotations[index][3] = cosf(angles[i] * 0.5f);
+        g_transforms.flags[index] |= RTRANSFORM_LOCAL_DIRTY;
     }
 }
 
 void rtransform_get_world_position(rtransform_t* transform, vec3 out_position) {
-    if (transform) {
-        out_position[0] = transform->world[3][0];
-        out_position[1] = transform->world[3][1];
-        out_position[2] = transform->world[3][2];
+    if (transform && transform->index != RTRANSFORM_NONE) {
+        rtransform_resolve(transform->index);
+        out_position[0] = g_transforms.worlds[transform->index][3][0];
+        out_position[1] = g_transforms.worlds[transform->index][3][1];
+        out_position[2] = g_transforms.worlds[transform->index][3][2];
     } else if (out_position) {
         out_position[0] = out_position[1] = out_position[2] = 0.0f;
     }
 }
 
+void rtransform_get_world_matrix(rtransform_t* transform, mat4x4 out_world) {
+    if (transform && transform->index != RTRANSFORM_NONE) {
+        rtransform_resolve(transform->index);
+        mat4x4_dup(out_world, g_transforms.worlds[transform->index]);
+    } else if (out_world) {
+        mat4x4_identity(out_world);
+    }
+}
+
 void rtransform_update(rtransform_t* transform) {
-    if (!transform) return;
-    
-    // Build local transform matrix
-    mat4x4 translation, rotation, scale, temp;
-    
-    // Translation matrix
-    mat4x4_identity(translation);
-    translation[3][0] = transform->position[0];
-    translation[3][1] = transform->position[1];
-    translation[3][2] = transform->position[2];
-    
-    // Rotation matrix from quaternion
-    mat4x4_from_quat(rotation, transform->rotation);
-    
-    // Scale matrix
-    mat4x4_identity(scale);
-    scale[0][0] = transform->scale[0];
-    scale[1][1] = transform->scale[1];
-    scale[2][2] = transform->scale[2];
-    
-    // Combine: local = translation * rotation * scale
-    mat4x4_mul(temp, translation, rotation);
-    mat4x4_mul(transform->local, temp, scale);
-    
-    // Calculate world matrix
-    if (transform->parent) {
-        mat4x4_mul(transform->world, transform->parent->world, transform->local);
-    } else {
-        mat4x4_dup(transform->world, transform->local);
+    if (!transform || transform->index == RTRANSFORM_NONE) return;
+    rtransform_resolve(transform->index);
+}
+
+void rtransform_update_all(void) {
+    if (g_transforms.needs_sort) {
+        if (!rtransform_sort()) {
+            rlog_error("rtransform: failed to sort transform hierarchy");
+            return;
+        }
+        g_transforms.needs_sort = false;
+    }
+
+    // Blocks keep each slice of the SoA arrays in cache across both passes. The first pass is
+    // a straight compose loop over the block with no parent lookups, so it unrolls and
+    // pipelines well; the second derives worlds in topological order.
+    uint32_t count = g_transforms.count;
+    for (uint32_t base = 0; base < count; base += RTRANSFORM_UPDATE_BLOCK) {
+        uint32_t end = base + RTRANSFORM_UPDATE_BLOCK < count ? base + RTRANSFORM_UPDATE_BLOCK : count;
+
+        for (uint32_t i = base; i < end; ++i) {
+            if (g_transforms.flags[i] & RTRANSFORM_LOCAL_DIRTY) {
+                mat4x4_compose_trs(g_transforms.locals[i],
+                                   g_transforms.positions[i],
+                                   g_transforms.rotations[i],
+                                   g_transforms.scales[i]);
+                g_transforms.flags[i] = RTRANSFORM_WORLD_DIRTY;
+            }
+        }
+
+        for (uint32_t i = base; i < end; ++i) {
+            if (rtransform_is_stale(i)) {
+                rtransform_compute(i);
+            }
+        }
     }
-}
\ No newline at end of file
+}
+
+void rtransform_shutdown(void) {
+    free(g_transforms.positions);
+    free(g_transforms.scales);
+    free(g_transforms.rotations);
+    free(g_transforms.locals);
+    free(g_transforms.worlds);
+    free(g_transforms.parents);
+    free(g_transforms.versions);
+    free(g_transforms.parent_versions);
+    free(g_transforms.child_counts);
+    free(g_transforms.flags);
+    free(g_transforms.owners);
+    free(g_transforms.scratch);
+
+    for (uint32_t i = 0; i < g_transforms.chunk_count; ++i) {
+        free(g_transforms.chunks[i]);
+    }
+    free(g_transforms.chunks);
+
+    memset(&g_transforms, 0, sizeof(g_transforms));
+}
@@ -0,0 +1,237 @@
+/*
+    asset_pack - bundles loose asset files into one .rpak the runtime maps with rasset_mount
+
+    Usage: asset_pack <output .rpak> <entry list>
+
+    The entry list holds one "<name>=<file>" line per asset, where <name> is the path the
+    runtime asks for (e.g. "assets/shaders/basic_texture.vert") and <file> is where to read it
+    now. Blank lines are skipped; a later line for the same name replaces the earlier one, so
+    an example's assets can override the engine's.
+*/
+
+#include "raster/impl/raster_asset_rpak.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct
+{
+    char*          name;
+    char*          file;
+    unsigned char* data;
+    uint32_t       size;
+} pack_entry_t;
+
+typedef struct
+{
+    pack_entry_t* entries;
+    uint32_t      count;
+    uint32_t      capacity;
+} pack_t;
+
+static uint32_t pack_align(uint32_t value, uint32_t alignment)
+{
+    return (value + alignment - 1u) & ~(alignment - 1u);
+}
+
+static char* pack_strdup(const char* text, size_t length)
+{
+    char* copy = (char*)malloc(length + 1);
+    if (copy)
+    {
+        memcpy(copy, text, length);
+        copy[length] = '\0';
+    }
+    return copy;
+}
+
+static int pack_add(pack_t* pack, const char* name, size_t name_length, const char* file, size_t file_length)
+{
+    for (uint32_t i = 0; i < pack->count; ++i)
+    {
+        if (strlen(pack->entries[i].name) == name_length && strncmp(pack->entries[i].name, name, name_length) == 0)
+        {
+            free(pack->entries[i].file);
+            pack->entries[i].file = pack_strdup(file, file_length);
+            return pack->entries[i].file != NULL;
+        }
+    }
+
+    if (pack->count == pack->capacity)
+    {
+        uint32_t      capacity = pack->capacity ? pack->capacity * 2u : 64u;
+        pack_entry_t* entries  = (pack_entry_t*)realloc(pack->entries, capacity * sizeof(pack_entry_t));
+        if (!entries)
+        {
+            return 0;
+        }
+        pack->entries  = entries;
+        pack->capacity = capacity;
+    }
+
+    pack_entry_t* entry = &pack->entries[pack->count++];
+    memset(entry, 0, sizeof(*entry));
+    entry->name = pack_strdup(name, name_length);
+    entry->file = pack_strdup(file, file_length);
+    return entry->name && entry->file;
+}
+
+static int pack_read_list(pack_t* pack, const char* list_path)
+{
+    FILE* list = fopen(list_path, "rb");
+    if (!list)
+    {
+        fprintf(stderr, "asset_pack: failed to open %s\n", list_path);
+        return 0;
+    }
+
+    char line[4096];
+    int  ok = 1;
+    while (ok && fgets(line, sizeof(line), list))
+    {
+        size_t length = strcspn(line, "\r\n");
+        line[length]  = '\0';
+        if (length == 0)
+        {
+            continue;
+        }
+
+        const char* separator = strchr(line, '=');
+        if (!separator || separator == line || separator[1] == '\0')
+        {
+            fprintf(stderr, "asset_pack: malformed entry \"%s\"\n", line);
+            ok = 0;
+            break;
+        }
+
+        ok = pack_add(pack, line, (size_t)(separator - line), separator + 1, strlen(separator + 1));
+    }
+
+    fclose(list);
+    return ok;
+}
+
+static int pack_load_entry(pack_entry_t* entry)
+{
+    FILE* file = fopen(entry->file, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "asset_pack: failed to open %s\n", entry->file);
+        return 0;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    entry->data = size >= 0 ? (unsigned char*)malloc((size_t)size + 1u) : NULL;
+    int ok      = entry->data && fread(entry->data, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+
+    if (!ok)
+    {
+        fprintf(stderr, "asset_pack: failed to read %s\n", entry->file);
+        return 0;
+    }
+
+    entry->size = (uint32_t)size;
+    return 1;
+}
+
+static int pack_write(const pack_t* pack, const char* output)
+{
+    rasset_rpak_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic       = RASSET_RPAK_MAGIC;
+    header.version     = RASSET_RPAK_VERSION;
+    header.entry_count = pack->count;
+
+    uint32_t names_begin = (uint32_t)(sizeof(header) + pack->count * sizeof(rasset_rpak_entry_t));
+    for (uint32_t i = 0; i < pack->count; ++i)
+    {
+        header.names_size += (uint32_t)strlen(pack->entries[i].name) + 1u;
+    }
+
+    rasset_rpak_entry_t* table = (rasset_rpak_entry_t*)calloc(pack->count ? pack->count : 1u, sizeof(rasset_rpak_entry_t));
+    if (!table)
+    {
+        return 0;
+    }
+
+    uint32_t name_offset = names_begin;
+    uint32_t data_offset = pack_align(names_begin + header.names_size, RASSET_RPAK_DATA_ALIGNMENT);
+    for (uint32_t i = 0; i < pack->count; ++i)
+    {
+        table[i].name_hash   = rasset_rpak_hash(pack->entries[i].name);
+        table[i].name_offset = name_offset;
+        table[i].data_offset = data_offset;
+        table[i].data_size   = pack->entries[i].size;
+        name_offset += (uint32_t)strlen(pack->entries[i].name) + 1u;
+        // The zero byte after each file lets the runtime hand out text in place
+        data_offset = pack_align(data_offset + pack->entries[i].size + 1u, RASSET_RPAK_DATA_ALIGNMENT);
+    }
+
+    FILE* file = fopen(output, "wb");
+    if (!file)
+    {
+        fprintf(stderr, "asset_pack: failed to open %s for writing\n", output);
+        free(table);
+        return 0;
+    }
+
+    unsigned char padding[RASSET_RPAK_DATA_ALIGNMENT] = { 0 };
+    uint32_t      written                             = names_begin;
+
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 && (pack->count == 0 || fwrite(table, sizeof(*table), pack->count, file) == pack->count);
+    for (uint32_t i = 0; ok && i < pack->count; ++i)
+    {
+        size_t length = strlen(pack->entries[i].name) + 1u;
+        ok            = fwrite(pack->entries[i].name, 1, length, file) == length;
+        written += (uint32_t)length;
+    }
+    for (uint32_t i = 0; ok && i < pack->count; ++i)
+    {
+        uint32_t gap = table[i].data_offset - written;
+        ok           = fwrite(padding, 1, gap, file) == gap && fwrite(pack->entries[i].data, 1, table[i].data_size, file) == table[i].data_size &&
+             fwrite(padding, 1, 1, file) == 1;
+        written = table[i].data_offset + table[i].data_size + 1u;
+    }
+
+    free(table);
+    if (fclose(file) != 0 || !ok)
+    {
+        fprintf(stderr, "asset_pack: failed to write %s\n", output);
+        remove(output);
+        return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: asset_pack <output .rpak> <entry list>\n");
+        return 1;
+    }
+
+    pack_t pack = { 0 };
+    int    ok   = pack_read_list(&pack, argv[2]);
+    for (uint32_t i = 0; ok && i < pack.count; ++i)
+    {
+        ok = pack_load_entry(&pack.entries[i]);
+    }
+
+    ok = ok && pack_write(&pack, argv[1]);
+
+    for (uint32_t i = 0; i < pack.count; ++i)
+    {
+        free(pack.entries[i].name);
+        free(pack.entries[i].file);
+        free(pack.entries[i].data);
+    }
+    free(pack.entries);
+
+    return ok ? 0 : 1;
+}
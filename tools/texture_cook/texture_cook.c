@@ -0,0 +1,183 @@
+/*
+    texture_cook - converts an image into a .rtex container the runtime can upload without decoding
+
+    Usage: texture_cook [--align 1|4] <input image> <output .rtex>
+
+    Decodes the image with stb_image, flips it the way rgfx texture loading does, builds the
+    full mip chain with a 2x2 box filter and writes every level with rows padded to the
+    requested alignment (4 by default). Two-channel images are widened to RGBA, matching the
+    formats the runtime knows how to upload.
+*/
+
+#include "raster/impl/raster_gfx_rtex.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb/stb_image.h>
+
+static uint32_t cook_align(uint32_t value, uint32_t alignment)
+{
+    return (value + alignment - 1u) & ~(alignment - 1u);
+}
+
+// Halves a tightly packed level; odd edges reuse the last row/column
+static void cook_downsample(const unsigned char* src, uint32_t src_width, uint32_t src_height, unsigned char* dst, uint32_t dst_width,
+                            uint32_t dst_height, uint32_t channels)
+{
+    for (uint32_t y = 0; y < dst_height; ++y)
+    {
+        uint32_t y0 = y * 2u < src_height ? y * 2u : src_height - 1u;
+        uint32_t y1 = y0 + 1u < src_height ? y0 + 1u : y0;
+        for (uint32_t x = 0; x < dst_width; ++x)
+        {
+            uint32_t x0 = x * 2u < src_width ? x * 2u : src_width - 1u;
+            uint32_t x1 = x0 + 1u < src_width ? x0 + 1u : x0;
+            for (uint32_t c = 0; c < channels; ++c)
+            {
+                uint32_t sum = src[(y0 * src_width + x0) * channels + c] + src[(y0 * src_width + x1) * channels + c] +
+                               src[(y1 * src_width + x0) * channels + c] + src[(y1 * src_width + x1) * channels + c];
+                dst[(y * dst_width + x) * channels + c] = (unsigned char)((sum + 2u) / 4u);
+            }
+        }
+    }
+}
+
+static int cook_write(const char* path, const rgfx_rtex_header_t* header, unsigned char* const* levels)
+{
+    FILE* file = fopen(path, "wb");
+    if (!file)
+    {
+        fprintf(stderr, "texture_cook: failed to open %s for writing\n", path);
+        return 0;
+    }
+
+    int           ok      = fwrite(header, sizeof(*header), 1, file) == 1;
+    unsigned char padding[RGFX_RTEX_LEVEL_ALIGNMENT] = { 0 };
+    uint32_t      written = (uint32_t)sizeof(*header);
+
+    for (uint32_t level = 0; ok && level < header->level_count; ++level)
+    {
+        uint32_t width  = rgfx_rtex_level_dimension(header->width, level);
+        uint32_t height = rgfx_rtex_level_dimension(header->height, level);
+        uint32_t row    = width * header->channels;
+        uint32_t pitch  = rgfx_rtex_row_pitch(width, header->channels, header->row_alignment);
+
+        ok = ok && fwrite(padding, 1, header->levels[level].offset - written, file) == header->levels[level].offset - written;
+        for (uint32_t y = 0; ok && y < height; ++y)
+        {
+            ok = fwrite(levels[level] + (size_t)y * row, 1, row, file) == row && fwrite(padding, 1, pitch - row, file) == pitch - row;
+        }
+        written = header->levels[level].offset + header->levels[level].size;
+    }
+
+    if (fclose(file) != 0 || !ok)
+    {
+        fprintf(stderr, "texture_cook: failed to write %s\n", path);
+        remove(path);
+        return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t row_alignment = 4u;
+    int      arg           = 1;
+    if (arg + 1 < argc && strcmp(argv[arg], "--align") == 0)
+    {
+        row_alignment = (uint32_t)atoi(argv[arg + 1]);
+        arg += 2;
+    }
+
+    if (argc - arg != 2 || (row_alignment != 1u && row_alignment != 4u))
+    {
+        fprintf(stderr, "usage: texture_cook [--align 1|4] <input image> <output .rtex>\n");
+        return 1;
+    }
+
+    const char* input  = argv[arg];
+    const char* output = argv[arg + 1];
+
+    int width    = 0;
+    int height   = 0;
+    int channels = 0;
+    if (!stbi_info(input, &width, &height, &channels))
+    {
+        fprintf(stderr, "texture_cook: failed to read %s: %s\n", input, stbi_failure_reason());
+        return 1;
+    }
+
+    int desired = channels == 2 ? 4 : 0;
+    stbi_set_flip_vertically_on_load(1);
+    unsigned char* pixels = stbi_load(input, &width, &height, &channels, desired);
+    if (!pixels)
+    {
+        fprintf(stderr, "texture_cook: failed to decode %s: %s\n", input, stbi_failure_reason());
+        return 1;
+    }
+    if (desired)
+    {
+        channels = desired;
+    }
+
+    rgfx_rtex_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic         = RGFX_RTEX_MAGIC;
+    header.version       = RGFX_RTEX_VERSION;
+    header.width         = (uint32_t)width;
+    header.height        = (uint32_t)height;
+    header.channels      = (uint32_t)channels;
+    header.row_alignment = row_alignment;
+    header.flags         = RGFX_RTEX_FLAG_FLIPPED;
+
+    unsigned char* levels[RGFX_RTEX_MAX_LEVELS] = { pixels };
+    uint32_t       offset                       = cook_align((uint32_t)sizeof(header), RGFX_RTEX_LEVEL_ALIGNMENT);
+    int            ok                           = 1;
+
+    for (uint32_t level = 0; level < RGFX_RTEX_MAX_LEVELS; ++level)
+    {
+        uint32_t level_width  = rgfx_rtex_level_dimension(header.width, level);
+        uint32_t level_height = rgfx_rtex_level_dimension(header.height, level);
+
+        if (level > 0)
+        {
+            levels[level] = (unsigned char*)malloc((size_t)level_width * level_height * header.channels);
+            if (!levels[level])
+            {
+                fprintf(stderr, "texture_cook: out of memory\n");
+                ok = 0;
+                break;
+            }
+            cook_downsample(levels[level - 1],
+                            rgfx_rtex_level_dimension(header.width, level - 1),
+                            rgfx_rtex_level_dimension(header.height, level - 1),
+                            levels[level],
+                            level_width,
+                            level_height,
+                            header.channels);
+        }
+
+        header.levels[level].offset = offset;
+        header.levels[level].size   = rgfx_rtex_row_pitch(level_width, header.channels, row_alignment) * level_height;
+        offset                      = cook_align(offset + header.levels[level].size, RGFX_RTEX_LEVEL_ALIGNMENT);
+        header.level_count          = level + 1u;
+
+        if (level_width == 1u && level_height == 1u)
+        {
+            break;
+        }
+    }
+
+    ok = ok && cook_write(output, &header, levels);
+
+    stbi_image_free(pixels);
+    for (uint32_t level = 1; level < RGFX_RTEX_MAX_LEVELS; ++level)
+    {
+        free(levels[level]);
+    }
+
+    return ok ? 0 : 1;
+}